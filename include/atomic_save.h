@@ -0,0 +1,35 @@
+#ifndef ATOMIC_SAVE_H
+#define ATOMIC_SAVE_H
+
+#include "bios_types.h"
+#include "report.h"
+
+// How much a completed save survives.
+// Every level writes a temp file and renames it over the target, so a crash
+// never leaves a half-written file; higher levels also flush to the disk.
+typedef enum {
+    SAVE_DURABILITY_NONE = 0,   // Rename only; the OS flushes when it likes
+    SAVE_DURABILITY_DATA = 1,   // Flush file contents before the rename
+    SAVE_DURABILITY_FULL = 2    // Also flush the directory entry (default)
+} save_durability_t;
+
+// Directories whose flush has been deferred by batched saves
+typedef struct {
+    char **directories;
+    size_t count;
+    size_t capacity;
+} save_batch_t;
+
+// Process-wide durability level
+void set_save_durability(save_durability_t durability);
+save_durability_t get_save_durability(void);
+
+// Replace filename with data in one write; batch NULL flushes the directory right away
+int write_file_atomic(const char *filename, const void *data, size_t size, save_batch_t *batch,
+                      bios_report_t *report);
+
+// Batched saves: one directory flush per distinct directory, at commit
+void init_save_batch(save_batch_t *batch);
+int commit_save_batch(save_batch_t *batch, bios_report_t *report);
+
+#endif // ATOMIC_SAVE_H
\ No newline at end of file
@@ -0,0 +1,34 @@
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+#include "bios_types.h"
+
+#define BATCH_LINE_MAX 256
+
+// Scripted get/set/validate/save against one loaded configuration.
+// Operations are applied in memory; the file is written once, when the session closes.
+//
+//   get NAME          print NAME=value
+//   set NAME VALUE    range-checked update (booleans also accept on/off, true/false)
+//   list              print every setting as NAME=value
+//   validate          run the full validator
+//   save [FILE]       write on close (to FILE, or back to the input file)
+//   compact [FILE]    as save, in the compact ID/value format
+//   # comment
+typedef struct {
+    bios_config_t config;
+    const char *input_path;
+    char output_path[BATCH_LINE_MAX];
+    FILE *out;                  // Results and messages
+    int save_requested;
+    int save_compact;
+    size_t op_count;
+    size_t error_count;
+} batch_session_t;
+
+int open_batch_session(batch_session_t *session, const char *config_path, FILE *out);
+int run_batch_command(batch_session_t *session, char *line, size_t line_number);
+int run_batch_script(batch_session_t *session, FILE *script);
+int close_batch_session(batch_session_t *session);
+
+#endif // BATCH_RUNNER_H
\ No newline at end of file
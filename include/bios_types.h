@@ -15,9 +15,12 @@
 // System Configuration File Format
 #define BIOS_SIGNATURE "SYSC"
 #define BIOS_VERSION 1
+#define BIOS_VERSION_CRC32C 2       // Header followed by bios_integrity_ext_t
+#define BIOS_VERSION_COMPACT 3      // Header followed by (setting ID, value) pairs, see config_compact.h
 #define MAX_SETTING_NAME 32
 #define MAX_SETTING_DATA 16
 #define MAX_SETTINGS 64
+#define NAME_INDEX_SLOTS 128        // Power of two, at least 2 * MAX_SETTINGS
 
 // Setting Data Types
 typedef enum {
@@ -47,6 +50,19 @@ typedef struct __attribute__((packed)) {
     uint16_t reserved;          // Padding
 } bios_config_header_t;
 
+// Integrity Algorithms
+typedef enum {
+    BIOS_INTEGRITY_SUM16 = 0,        // Legacy additive checksum only
+    BIOS_INTEGRITY_CRC32C = 1        // Additive checksum plus CRC32C
+} bios_integrity_t;
+
+// Integrity extension, present after the header in version 2 files
+typedef struct __attribute__((packed)) {
+    uint32_t crc32c;            // CRC32C over the settings
+    uint16_t algorithm;         // bios_integrity_t
+    uint16_t reserved;          // Padding
+} bios_integrity_ext_t;
+
 // Individual System Setting
 typedef struct __attribute__((packed)) {
     char name[MAX_SETTING_NAME];     // Setting name
@@ -59,11 +75,20 @@ typedef struct __attribute__((packed)) {
     uint32_t max_value;              // Maximum allowed value
 } bios_setting_t;
 
+// Name lookup index (in-memory only, never written to disk)
+typedef struct {
+    uint16_t slots[NAME_INDEX_SLOTS];  // Setting position + 1, 0 = empty
+    int indexed_count;                 // Settings covered when last built
+} bios_name_index_t;
+
 // System Configuration Container
 typedef struct {
     bios_config_header_t header;
     bios_setting_t settings[MAX_SETTINGS];
     int setting_count;
+    bios_name_index_t name_index;
+    int checksum_stale;                // header.checksum does not match settings
+    int integrity;                     // bios_integrity_t used when saving
 } bios_config_t;
 
 // Return codes
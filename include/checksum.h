@@ -0,0 +1,24 @@
+#ifndef CHECKSUM_H
+#define CHECKSUM_H
+
+#include "bios_types.h"
+
+// Checksum kernel selection
+typedef enum {
+    CHECKSUM_KERNEL_AUTO = 0,    // Best kernel supported by this CPU
+    CHECKSUM_KERNEL_SCALAR = 1,  // Portable byte loop / table CRC
+    CHECKSUM_KERNEL_SSE2 = 2,
+    CHECKSUM_KERNEL_AVX2 = 3
+} checksum_kernel_t;
+
+// Integrity kernels
+uint16_t checksum_sum16(const void *data, size_t size);
+uint32_t checksum_crc32c(uint32_t crc, const void *data, size_t size);
+
+// Kernel dispatch
+int select_checksum_kernel(checksum_kernel_t kernel);
+checksum_kernel_t get_checksum_kernel(void);
+const char* get_checksum_kernel_name(checksum_kernel_t kernel);
+int checksum_crc32c_hardware(void);
+
+#endif // CHECKSUM_H
\ No newline at end of file
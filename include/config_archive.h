@@ -0,0 +1,96 @@
+#ifndef CONFIG_ARCHIVE_H
+#define CONFIG_ARCHIVE_H
+
+#include "bios_types.h"
+#include "report.h"
+#include "config_pack.h"
+
+// Archive layout:
+//   bios_archive_header_t
+//   record 0 .. record N-1       (complete SYSC images, back to back)
+//   bios_archive_entry_t[N]     (index, sorted by key)
+//   bios_archive_trailer_t      (locates the index)
+// All offsets are 64-bit, so the archive is not limited by header.data_size.
+//
+// Packed archives (version 2) store records in the config_pack encoding,
+// write the schema dictionary just before the index, and insert a
+// bios_archive_dict_t locating it between the index and the trailer.
+
+#define ARCHIVE_SIGNATURE "SYSA"
+#define ARCHIVE_INDEX_MAGIC "SYSI"
+#define ARCHIVE_VERSION 1
+#define ARCHIVE_VERSION_PACKED 2
+#define ARCHIVE_KEY_LEN 48
+
+#pragma pack(push, 1)
+typedef struct {
+    char signature[4];          // "SYSA"
+    uint16_t version;           // Archive format version
+    uint16_t reserved;
+} bios_archive_header_t;
+
+typedef struct {
+    char key[ARCHIVE_KEY_LEN];  // NUL-padded record key
+    uint64_t offset;            // Record start, from the beginning of the archive
+    uint64_t length;            // Record size in bytes
+    uint32_t crc32c;            // CRC32C over the record bytes
+    uint32_t reserved;
+} bios_archive_entry_t;
+
+typedef struct {
+    uint64_t offset;            // Start of the schema dictionary
+    uint64_t size;              // Dictionary size in bytes
+    uint32_t crc32c;            // CRC32C over the dictionary
+    uint32_t reserved;
+} bios_archive_dict_t;
+
+typedef struct {
+    uint64_t index_offset;      // Start of the index
+    uint64_t entry_count;       // Number of index entries
+    uint32_t index_crc32c;      // CRC32C over the index entries
+    char magic[4];              // "SYSI"
+} bios_archive_trailer_t;
+#pragma pack(pop)
+
+// Streaming writer
+typedef struct {
+    FILE *file;
+    uint64_t position;              // Next record offset
+    bios_archive_entry_t *entries;  // Index entries in append order
+    size_t entry_count;
+    size_t entry_capacity;
+    int packed;                     // Records are stored packed
+    pack_dictionary_t dictionary;   // Schemas seen so far (packed only)
+    int failed;                     // A write failed; position no longer matches the file
+} bios_archive_writer_t;
+
+// Random-access reader; the index is held in memory
+typedef struct {
+    FILE *file;
+    uint64_t file_size;
+    bios_archive_entry_t *entries;  // Sorted by key
+    size_t entry_count;
+    int packed;
+    pack_dictionary_t dictionary;
+} bios_archive_t;
+
+// Writing; after a failed write every later append and the close fail too
+int open_archive_writer(const char *filename, bios_archive_writer_t *writer);
+int open_packed_archive_writer(const char *filename, bios_archive_writer_t *writer);
+int archive_append_record(bios_archive_writer_t *writer, const char *key, const void *data, size_t size);
+int archive_append_config(bios_archive_writer_t *writer, const char *key, const bios_config_t *config);
+int close_archive_writer(bios_archive_writer_t *writer);
+
+// Reading
+int open_archive(const char *filename, bios_archive_t *archive);
+void close_archive(bios_archive_t *archive);
+const bios_archive_entry_t* archive_find(const bios_archive_t *archive, const char *key);
+const bios_archive_entry_t* archive_get_entry(const bios_archive_t *archive, size_t index);
+int archive_read_record(const bios_archive_t *archive, const bios_archive_entry_t *entry,
+                        void *buffer, size_t capacity);
+int archive_read_image(const bios_archive_t *archive, const bios_archive_entry_t *entry,
+                       uint8_t *image, size_t capacity, size_t *image_size);
+int archive_load_config(const bios_archive_t *archive, const char *key, bios_config_t *config,
+                        bios_report_t *report);
+
+#endif // CONFIG_ARCHIVE_H
\ No newline at end of file
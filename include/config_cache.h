@@ -0,0 +1,39 @@
+#ifndef CONFIG_CACHE_H
+#define CONFIG_CACHE_H
+
+#include "bios_types.h"
+#include "report.h"
+
+// Process-wide LRU cache of parsed, checksum-verified configurations.
+// Entries are keyed by file identity: device, inode (file index on Windows),
+// modification time and size. A hit costs one stat; any change to the file,
+// including an atomic save that replaces it, makes the next acquire re-parse.
+// The cache is safe to use from several threads.
+#define CONFIG_CACHE_DEFAULT_BUDGET (4 * 1024 * 1024)
+
+typedef struct {
+    size_t hits;
+    size_t misses;
+    size_t evictions;           // Dropped to stay within the budget
+    size_t invalidations;       // Dropped because the file changed
+    size_t entry_count;
+    size_t bytes_used;
+    size_t budget;
+} config_cache_stats_t;
+
+// Memory budget in bytes; 0 disables caching (acquire still works, nothing is kept)
+void set_config_cache_budget(size_t bytes);
+
+// Shared read-only instance; every successful acquire needs one release.
+// Messages from the original parse (e.g. checksum warnings) are replayed into report on a hit.
+int acquire_cached_config(const char *filename, const bios_config_t **config, bios_report_t *report);
+void release_cached_config(const bios_config_t *config);
+
+// Private copy through the cache, for callers that modify the configuration
+int load_cached_config(const char *filename, bios_config_t *config, bios_report_t *report);
+
+void get_config_cache_stats(config_cache_stats_t *stats);
+void print_config_cache_stats(void);
+void clear_config_cache(void);
+
+#endif // CONFIG_CACHE_H
\ No newline at end of file
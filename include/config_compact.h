@@ -0,0 +1,27 @@
+#ifndef CONFIG_COMPACT_H
+#define CONFIG_COMPACT_H
+
+#include "bios_types.h"
+#include "report.h"
+
+// Compact (version 3) files: the standard header, then one (u16 setting ID, value)
+// pair per setting, the value taking the setting's declared size. Everything else
+// comes from the schema registry. header.reserved holds the schema version and
+// header.checksum covers the expanded settings, as in version 1.
+
+#define MAX_COMPACT_PAYLOAD(count) ((size_t)(count) * (sizeof(uint16_t) + MAX_SETTING_DATA))
+
+// Writing
+int serialize_compact_image(const bios_config_t *config, uint8_t *buffer, size_t capacity, size_t *image_size,
+                            bios_report_t *report);
+int save_bios_config_compact(const char *filename, const bios_config_t *config);
+int save_bios_config_compact_report(const char *filename, const bios_config_t *config, bios_report_t *report);
+
+// Reading; used by the parsers when they find a version 3 header. On success the
+// header is rewritten to describe the expanded settings (version 1 layout)
+int expand_compact_settings(bios_config_header_t *header, const uint8_t *payload,
+                            bios_setting_t *settings, int capacity, bios_report_t *report);
+int read_compact_settings(FILE *file, const char *filename, bios_config_header_t *header,
+                          bios_setting_t *settings, int capacity, bios_report_t *report);
+
+#endif // CONFIG_COMPACT_H
\ No newline at end of file
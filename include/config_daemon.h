@@ -0,0 +1,65 @@
+#ifndef CONFIG_DAEMON_H
+#define CONFIG_DAEMON_H
+
+#include "bios_types.h"
+#include "report.h"
+#include <signal.h>
+
+// Long-running query server: keeps configurations loaded and answers requests
+// over a Unix domain socket, driven by an epoll event loop (Linux only).
+//
+// Every message is a daemon_frame_t followed by `length` payload bytes, in host
+// byte order (the socket is local). Requests may be pipelined; responses come
+// back in request order with the same opcode and a BIOS_* status. Failed
+// requests carry the error message as their payload.
+#define DAEMON_MAX_PAYLOAD 8192
+#define DAEMON_PATH_MAX 108             // sun_path size
+#define DAEMON_CONFIG_PATH_MAX 256
+
+typedef struct __attribute__((packed)) {
+    uint32_t length;            // Payload bytes after the frame
+    uint8_t opcode;
+    uint8_t reserved;
+    int16_t status;             // Responses: BIOS_SUCCESS or BIOS_ERROR_*
+} daemon_frame_t;
+
+// Request payload -> response payload. Handles come from OPEN and stay valid
+// for the daemon's lifetime; names are sent without a terminator.
+typedef enum {
+    DAEMON_OP_OPEN = 1,         // path -> u32 handle, u16 setting count
+    DAEMON_OP_GET = 2,          // u32 handle, name -> u32 value
+    DAEMON_OP_SET = 3,          // u32 handle, u32 value, name -> (empty); range checked
+    DAEMON_OP_VALIDATE = 4,     // u32 handle -> u16 errors, u16 warnings, '\n'-separated messages
+    DAEMON_OP_DIFF = 5,         // u32 handle, u32 handle -> u16 count, then per setting:
+                                //   u8 name length, name, u8 presence (1 first, 2 second, 3 both), u32, u32
+    DAEMON_OP_SAVE = 6          // u32 handle[, path] -> (empty); default is the file it was opened from
+} daemon_opcode_t;
+
+typedef struct daemon_connection daemon_connection_t;
+
+typedef struct {
+    char path[DAEMON_CONFIG_PATH_MAX];
+    bios_config_t config;
+    int modified;               // Changed by SET since it was loaded or saved
+} daemon_config_slot_t;
+
+typedef struct {
+    int listen_fd;
+    int epoll_fd;
+    char socket_path[DAEMON_PATH_MAX];
+    daemon_config_slot_t *configs;      // Indexed by handle
+    int config_count;
+    int config_capacity;
+    daemon_connection_t *connections;
+    volatile sig_atomic_t stop_requested;   // Set from signal handlers
+    size_t request_count;
+} config_daemon_t;
+
+// Server lifecycle; a stale socket at socket_path is replaced, any other file is an error.
+// The socket is created owner-only (0600).
+int open_config_daemon(config_daemon_t *daemon, const char *socket_path);
+int run_config_daemon(config_daemon_t *daemon);     // Serve until stop_config_daemon()
+void stop_config_daemon(config_daemon_t *daemon);   // Safe from a signal handler
+void close_config_daemon(config_daemon_t *daemon);
+
+#endif // CONFIG_DAEMON_H
\ No newline at end of file
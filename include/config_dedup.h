@@ -0,0 +1,75 @@
+#ifndef CONFIG_DEDUP_H
+#define CONFIG_DEDUP_H
+
+#include "bios_types.h"
+#include "report.h"
+
+// Content-addressed store for many machines' configurations.
+// Each distinct settings payload is kept once, found by a 64-bit hash of its
+// bytes (confirmed by comparing them) and reference counted; every machine
+// keeps only its header and a reference. Validation depends only on the
+// settings, so its result is cached per payload and runs once however many
+// machines share it.
+#define DEDUP_SIGNATURE "SYSS"
+#define DEDUP_VERSION 1
+#define DEDUP_MACHINE_MAX 64
+#define DEDUP_NOT_VALIDATED 1           // validation_result before the first validation
+
+typedef struct {
+    uint64_t hash;
+    uint32_t ref_count;                 // Machines using this payload; 0 = free slot
+    int setting_count;
+    bios_setting_t *settings;
+    int validation_result;              // Cached validate_settings_table() result
+    bios_report_t *validation_report;   // Its messages, NULL until validated
+    uint32_t next;                      // Hash chain, or free list when unused (index + 1, 0 ends)
+} dedup_blob_t;
+
+typedef struct {
+    char machine[DEDUP_MACHINE_MAX];
+    bios_config_header_t header;
+    int integrity;
+    uint32_t blob;                      // Index into blobs
+    uint32_t next;                      // Name hash chain (index + 1, 0 ends)
+} dedup_ref_t;
+
+typedef struct {
+    size_t machine_count;
+    size_t unique_count;                // Distinct payloads stored
+    size_t logical_bytes;               // Settings bytes if every machine kept its own copy
+    size_t stored_bytes;                // Settings bytes actually kept
+    size_t validations_run;
+    size_t validations_cached;
+} dedup_stats_t;
+
+typedef struct {
+    dedup_blob_t *blobs;
+    size_t blob_count;                  // Slots in use or on the free list
+    size_t blob_capacity;
+    uint32_t free_blobs;                // Free list head (index + 1)
+    uint32_t *blob_buckets;             // By payload hash
+    dedup_ref_t *refs;
+    size_t ref_count;
+    size_t ref_capacity;
+    uint32_t *ref_buckets;              // By machine name
+    size_t bucket_count;                // Power of two, shared by both tables
+    dedup_stats_t stats;
+} dedup_store_t;
+
+void init_dedup_store(dedup_store_t *store);
+void free_dedup_store(dedup_store_t *store);
+
+// Machines; putting an existing machine replaces its configuration
+int dedup_store_put(dedup_store_t *store, const char *machine, const bios_config_t *config);
+int dedup_store_get(const dedup_store_t *store, const char *machine, bios_config_t *config);
+int dedup_store_remove(dedup_store_t *store, const char *machine);
+
+// Cached validation; messages are added to report (NULL prints them)
+int dedup_store_validate(dedup_store_t *store, const char *machine, bios_report_t *report);
+void get_dedup_stats(const dedup_store_t *store, dedup_stats_t *stats);
+
+// Persistence: each distinct payload is written once
+int save_dedup_store(const dedup_store_t *store, const char *filename);
+int load_dedup_store(const char *filename, dedup_store_t *store);
+
+#endif // CONFIG_DEDUP_H
\ No newline at end of file
@@ -0,0 +1,40 @@
+#ifndef CONFIG_DELTA_H
+#define CONFIG_DELTA_H
+
+#include "bios_types.h"
+
+// Delta File Format: header followed by num_entries variable-length entries
+#define DELTA_SIGNATURE "SYSD"
+#define DELTA_VERSION 1
+
+typedef struct __attribute__((packed)) {
+    char signature[4];          // "SYSD"
+    uint16_t version;           // Delta format version
+    uint16_t num_entries;       // Changed settings
+    uint16_t base_setting_count;// Settings in the base configuration
+    uint16_t base_checksum;     // Checksum the base must have
+    uint16_t result_checksum;   // Checksum after applying the delta
+    uint16_t reserved;          // Padding
+} bios_delta_header_t;
+
+// Entry header, followed by the setting's declared size in bytes, replacing the start of its data field
+typedef struct __attribute__((packed)) {
+    uint16_t setting_id;        // Position of the setting in the base
+    uint8_t size;               // New data bytes that follow
+} bios_delta_entry_t;
+
+// Worst case: every setting changes its whole data field
+#define MAX_DELTA_SIZE(setting_count) \
+    (sizeof(bios_delta_header_t) + (size_t)(setting_count) * (sizeof(bios_delta_entry_t) + MAX_SETTING_DATA))
+
+// Create and apply
+int create_config_delta(const bios_config_t *base, const bios_config_t *target,
+                        uint8_t *buffer, size_t capacity, size_t *delta_size);
+int apply_config_delta(bios_config_t *config, const uint8_t *delta, size_t delta_size);
+int verify_config_delta(const bios_config_t *base, const uint8_t *delta, size_t delta_size);
+
+// Delta files
+int save_config_delta(const char *filename, const uint8_t *delta, size_t delta_size);
+int load_config_delta(const char *filename, uint8_t *buffer, size_t capacity, size_t *delta_size);
+
+#endif // CONFIG_DELTA_H
\ No newline at end of file
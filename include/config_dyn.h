@@ -0,0 +1,41 @@
+#ifndef CONFIG_DYN_H
+#define CONFIG_DYN_H
+
+#include "bios_types.h"
+#include "report.h"
+
+#define MAX_DYN_SETTINGS 65534  // Index slots store position + 1 in 16 bits
+
+// Dynamically sized configuration. The struct, its settings array and its
+// name index share one arena allocation sized from the setting count, so
+// free_config_dyn() is a single free().
+typedef struct {
+    bios_config_header_t header;
+    bios_setting_t *settings;      // In the arena, setting_capacity entries
+    int setting_count;
+    int setting_capacity;
+    uint16_t *index_slots;         // In the arena, power of two > 2 * capacity
+    size_t index_slot_count;
+    int checksum_stale;            // header.checksum does not match settings
+    int integrity;                 // bios_integrity_t used when saving
+} bios_config_dyn_t;
+
+// Lifetime
+bios_config_dyn_t* create_config_dyn(int capacity);
+void free_config_dyn(bios_config_dyn_t *config);
+
+// File I/O
+int parse_bios_config_dyn(const char *filename, bios_config_dyn_t **config, bios_report_t *report);
+int save_bios_config_dyn(const char *filename, const bios_config_dyn_t *config);
+
+// Setting management; add_setting_dyn() may move the arena
+int add_setting_dyn(bios_config_dyn_t **config, const bios_setting_t *setting);
+int find_setting_index_dyn(const bios_config_dyn_t *config, const char *name);
+const bios_setting_t* find_setting_dyn(const bios_config_dyn_t *config, const char *name);
+int set_setting_dyn(bios_config_dyn_t *config, const char *name, const void *value);
+
+// Compatibility with the fixed bios_config_t container
+int config_dyn_to_fixed(const bios_config_dyn_t *config, bios_config_t *fixed);
+bios_config_dyn_t* config_dyn_from_fixed(const bios_config_t *fixed);
+
+#endif // CONFIG_DYN_H
\ No newline at end of file
@@ -0,0 +1,49 @@
+#ifndef CONFIG_EXPORT_H
+#define CONFIG_EXPORT_H
+
+#include "bios_types.h"
+#include "fleet_loader.h"
+
+// Machine-readable export of configurations.
+// Records are formatted straight into one large buffer (integers without
+// printf) and handed to the FILE in buffer-sized writes.
+//
+//   JSON Lines: one object per config
+//     {"source":"node1.bin","version":1,"checksum":1234,"checksum_ok":true,
+//      "settings":{"CPU_FREQ":3600,"ECC_ENABLE":true,...}}
+//   CSV: a header row, then one row per setting
+//     source,setting,category,type,value,min,max
+#define EXPORT_DEFAULT_BUFFER (1024 * 1024)
+#define EXPORT_MIN_BUFFER (64 * 1024)
+#define EXPORT_SOURCE_MAX 1024      // Longer source names are truncated
+
+typedef enum {
+    EXPORT_FORMAT_JSONL = 0,
+    EXPORT_FORMAT_CSV = 1
+} export_format_t;
+
+typedef struct {
+    FILE *out;
+    export_format_t format;
+    char *buffer;
+    size_t used;
+    size_t capacity;
+    int header_written;         // CSV header row
+    int failed;                 // A write failed; later calls fail too
+    size_t record_count;        // Configs exported
+    uint64_t bytes_written;     // Bytes handed to out so far
+} config_exporter_t;
+
+int parse_export_format(const char *name, export_format_t *format);
+
+// buffer_size 0 selects EXPORT_DEFAULT_BUFFER. Closing flushes but leaves out open.
+int open_config_exporter(config_exporter_t *exporter, FILE *out, export_format_t format, size_t buffer_size);
+int export_config(config_exporter_t *exporter, const char *source, const bios_config_t *config);
+int flush_config_exporter(config_exporter_t *exporter);
+int close_config_exporter(config_exporter_t *exporter);
+
+// Parse the files on a work-stealing pool (thread_count <= 0: one per core) and export
+// them in path order. Files that do not parse are skipped and counted in *failed_count.
+int export_fleet(const fleet_paths_t *paths, int thread_count, config_exporter_t *exporter, size_t *failed_count);
+
+#endif // CONFIG_EXPORT_H
\ No newline at end of file
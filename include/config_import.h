@@ -0,0 +1,42 @@
+#ifndef CONFIG_IMPORT_H
+#define CONFIG_IMPORT_H
+
+#include "bios_types.h"
+#include "report.h"
+#include "fleet_loader.h"
+
+// Text descriptions of a configuration, compiled to SYSC files.
+// Every record starts from the default configuration; each listed setting is
+// range-checked against its declared min/max as it is read. Unknown settings,
+// bad values and syntax errors are reported with their line number.
+//
+//   JSON: {"CPU_FREQ": 3600, "ECC_ENABLE": true}
+//         Records written by --export are accepted too: their settings are
+//         read from "settings" and "source" names the compiled file.
+//   INI:  CPU_FREQ = 3600
+//         ECC_ENABLE = on          # booleans: true/false, on/off, 1/0
+//         [Memory]                 # sections and comments (# or ;) are ignored
+//
+// The format is chosen by content: text starting with '{' is JSON.
+#define IMPORT_MAX_TEXT (1024 * 1024)       // Largest single input file or JSON Lines record
+
+typedef struct {
+    bios_config_t defaults;                 // Every record starts from these
+    char source[FLEET_PATH_MAX];            // "source" of the last JSON record, empty if none
+} config_importer_t;
+
+void init_config_importer(config_importer_t *importer);
+int import_config_text(config_importer_t *importer, const char *text, size_t length, bios_config_t *config,
+                       bios_report_t *report);
+int import_config_file(config_importer_t *importer, const char *filename, bios_config_t *config,
+                       bios_report_t *report);
+
+// Import input and save it with save_bios_config()
+int compile_config_file(const char *input, const char *output, bios_report_t *report);
+
+// One JSON record per line, each saved into output_dir as <source name>.bin
+// (or record<line>.bin). A source name already written by an earlier record falls
+// back to record<line>.bin with a warning. Failed records are reported and skipped.
+int compile_config_lines(const char *input, const char *output_dir, size_t *compiled_count, size_t *failed_count);
+
+#endif // CONFIG_IMPORT_H
\ No newline at end of file
@@ -0,0 +1,47 @@
+#ifndef CONFIG_PACK_H
+#define CONFIG_PACK_H
+
+#include "bios_types.h"
+#include "config_parser.h"
+
+// Compact encoding of configuration images for packed archives.
+// Setting descriptors (name, category, type, size, flags, limits) are stored
+// once per archive in a schema dictionary; each record keeps only a schema id
+// and the setting values, bit-packed by declared type/size (1 bit for bools).
+// Anything the encoding cannot reproduce exactly is stored as the raw image,
+// so unpacking always returns the original bytes.
+
+#define PACK_FLAG_RAW 0x01          // Record is the raw image
+#define PACK_FLAG_CRC32C 0x02       // Version 2 image; extension is recomputed
+#define PACK_FLAG_EXPLICIT 0x04     // Header (and extension) stored verbatim
+
+#define MAX_PACKED_RECORD_SIZE (1 + MAX_CONFIG_IMAGE_SIZE(MAX_SETTINGS))
+
+// One distinct settings layout; descriptors have their data bytes zeroed
+typedef struct {
+    int setting_count;
+    bios_setting_t settings[MAX_SETTINGS];
+} pack_schema_t;
+
+typedef struct {
+    pack_schema_t *schemas;
+    size_t count;
+    size_t capacity;
+    size_t last_match;              // Most fleets use one schema; try it first
+} pack_dictionary_t;
+
+void init_pack_dictionary(pack_dictionary_t *dictionary);
+void free_pack_dictionary(pack_dictionary_t *dictionary);
+
+// Dictionary storage
+size_t pack_dictionary_size(const pack_dictionary_t *dictionary);
+void serialize_pack_dictionary(const pack_dictionary_t *dictionary, uint8_t *buffer);
+int load_pack_dictionary(pack_dictionary_t *dictionary, const uint8_t *data, size_t size);
+
+// Record encoding; packing adds new schemas to the dictionary
+int pack_config_image(pack_dictionary_t *dictionary, const uint8_t *image, size_t image_size,
+                      uint8_t *packed, size_t capacity, size_t *packed_size);
+int unpack_config_image(const pack_dictionary_t *dictionary, const uint8_t *packed, size_t packed_size,
+                        uint8_t *image, size_t capacity, size_t *image_size);
+
+#endif // CONFIG_PACK_H
\ No newline at end of file
@@ -2,6 +2,8 @@
 #define CONFIG_PARSER_H
 
 #include "bios_types.h"
+#include "report.h"
+#include "atomic_save.h"
 
 // Forward declarations
 struct bios_config;
@@ -9,7 +11,31 @@ struct bios_setting;
 
 // Core parsing functions
 int parse_bios_config(const char *filename, bios_config_t *config);
+int parse_bios_config_report(const char *filename, bios_config_t *config, bios_report_t *report);
 int save_bios_config(const char *filename, const bios_config_t *config);
+int save_bios_config_report(const char *filename, const bios_config_t *config, bios_report_t *report);
+int save_bios_config_batched(save_batch_t *batch, const char *filename, const bios_config_t *config,
+                             bios_report_t *report);
+
+// Largest serialized image for a given number of settings
+#define MAX_CONFIG_IMAGE_SIZE(setting_count) \
+    (sizeof(bios_config_header_t) + sizeof(bios_integrity_ext_t) + sizeof(bios_setting_t) * (size_t)(setting_count))
+
+// In-memory images
+int serialize_config_image(const bios_config_header_t *base_header, const bios_setting_t *settings, int count,
+                           int integrity, uint8_t *buffer, size_t capacity, size_t *image_size);
+int serialize_bios_config(const bios_config_t *config, uint8_t *buffer, size_t capacity, size_t *image_size);
+int parse_bios_config_image(const uint8_t *image, size_t size, bios_config_t *config, bios_report_t *report);
+
+// Low-level file access shared by the fixed and dynamic containers
+int read_config_header(FILE *file, const char *filename, bios_config_header_t *header,
+                       bios_integrity_ext_t *ext, bios_report_t *report);
+int verify_config_integrity(const bios_config_header_t *header, const bios_integrity_ext_t *ext,
+                            const bios_setting_t *settings, int count, int *checksum_stale,
+                            bios_report_t *report);
+int write_config_file(const char *filename, const bios_config_header_t *base_header,
+                      const bios_setting_t *settings, int count, int integrity, save_batch_t *batch,
+                      bios_report_t *report);
 
 // Configuration management
 int load_default_config(bios_config_t *config);
@@ -18,6 +44,9 @@ int validate_config(const bios_config_t *config);
 // Setting management
 int get_setting_by_name(const bios_config_t *config, const char *name, bios_setting_t *setting);
 int set_setting_by_name(bios_config_t *config, const char *name, const void *value);
+int find_setting_index(const bios_config_t *config, const char *name);
+const bios_setting_t* find_setting(const bios_config_t *config, const char *name);
+void rebuild_setting_index(bios_config_t *config);
 
 // Display functions
 void display_config_summary(const bios_config_t *config);
@@ -26,7 +55,12 @@ void display_category_settings(const bios_config_t *config, bios_category_t cate
 
 // Utility functions
 uint16_t calculate_checksum(const bios_config_t *config);
+uint16_t calculate_checksum_bytes(const void *data, size_t size);
+uint16_t update_checksum_bytes(uint16_t checksum, const void *old_data, const void *new_data, size_t size);
 const char* get_category_name(bios_category_t category);
 const char* get_type_name(bios_data_type_t type);
+uint32_t get_setting_value(const bios_setting_t *setting);
+int encode_setting_value(const bios_setting_t *setting, uint32_t value, uint8_t data[MAX_SETTING_DATA]);
+int parse_setting_text(const bios_setting_t *setting, const char *text, uint32_t *value);
 
 #endif // CONFIG_PARSER_H
\ No newline at end of file
@@ -0,0 +1,65 @@
+#ifndef CONFIG_SNAPSHOT_H
+#define CONFIG_SNAPSHOT_H
+
+#include "bios_types.h"
+#include <stdatomic.h>
+
+// Read-mostly sharing of one configuration between threads (RCU style).
+// Readers take the current immutable version without locks; the writer edits
+// a private copy and publishes it with one atomic swap. Replaced versions are
+// freed once no reader that could still see them is inside a read section
+// (epoch-based reclamation).
+//
+// Readers: register once per thread, then bracket each use
+//     const bios_config_t *config = read_snapshot_begin(&snapshot, reader);
+//     ... read config ...
+//     read_snapshot_end(reader);
+// Sections must not nest, and the pointer must not be used after the end.
+//
+// Writer: begin_snapshot_edit(), change the returned copy with the usual
+// set_setting_by_name() etc., then publish_snapshot_edit(). Edits must come
+// from one thread at a time.
+
+// One published version; never modified while readers can see it
+typedef struct config_version {
+    bios_config_t config;       // First, so a config pointer leads back to its version
+    uint64_t version;           // 1 for the initial configuration, +1 per publish
+    uint64_t retire_epoch;
+    struct config_version *next_retired;
+} config_version_t;
+
+typedef struct snapshot_reader {
+    _Atomic uint64_t epoch;     // Epoch the current section started in, 0 outside sections
+    _Atomic int in_use;
+    struct snapshot_reader *next;
+    char padding[64];           // Keep each reader's epoch on its own cache line
+} snapshot_reader_t;
+
+typedef struct {
+    _Atomic(config_version_t*) current;
+    _Atomic uint64_t epoch;
+    _Atomic(snapshot_reader_t*) readers;    // Never shrinks; slots are reused
+    config_version_t *retired;              // Writer only: waiting for readers to move on
+    size_t retired_count;
+    config_version_t *edit;                 // Writer only: unpublished copy
+} config_snapshot_t;
+
+// Lifecycle; destroy only when no reader is inside a section
+int init_config_snapshot(config_snapshot_t *snapshot, const bios_config_t *initial);
+void destroy_config_snapshot(config_snapshot_t *snapshot);
+
+// Readers
+snapshot_reader_t* register_snapshot_reader(config_snapshot_t *snapshot);
+void unregister_snapshot_reader(snapshot_reader_t *reader);
+const bios_config_t* read_snapshot_begin(config_snapshot_t *snapshot, snapshot_reader_t *reader);
+void read_snapshot_end(snapshot_reader_t *reader);
+uint64_t get_snapshot_version(const bios_config_t *config);
+
+// Writer
+bios_config_t* begin_snapshot_edit(config_snapshot_t *snapshot);
+int publish_snapshot_edit(config_snapshot_t *snapshot);
+void abort_snapshot_edit(config_snapshot_t *snapshot);
+int snapshot_set_setting(config_snapshot_t *snapshot, const char *name, const void *value);
+void reclaim_snapshots(config_snapshot_t *snapshot);
+
+#endif // CONFIG_SNAPSHOT_H
\ No newline at end of file
@@ -0,0 +1,32 @@
+#ifndef CONFIG_VIEW_H
+#define CONFIG_VIEW_H
+
+#include "bios_types.h"
+
+// Read-only, memory-mapped view of a configuration file.
+// Settings are accessed in place; nothing is copied out of the mapping.
+typedef struct {
+    const bios_config_header_t *header;     // Header inside the mapping
+    const bios_integrity_ext_t *integrity;  // Version 2 extension, or NULL
+    const bios_setting_t *settings;         // First setting inside the mapping
+    int setting_count;                      // Number of settings in the view
+    const void *map_base;                   // Start of the mapped file
+    size_t map_size;                        // Size of the mapped file
+#ifdef _WIN32
+    HANDLE file_handle;
+    HANDLE mapping_handle;
+#endif
+} bios_config_view_t;
+
+// View lifetime
+int open_bios_config_view(const char *filename, bios_config_view_t *view);
+void close_bios_config_view(bios_config_view_t *view);
+
+// In-place access
+const bios_setting_t* view_get_setting(const bios_config_view_t *view, int index);
+const bios_setting_t* view_find_setting(const bios_config_view_t *view, const char *name);
+
+// Integrity check over the mapped bytes
+int verify_view_checksum(const bios_config_view_t *view);
+
+#endif // CONFIG_VIEW_H
\ No newline at end of file
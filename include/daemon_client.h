@@ -0,0 +1,36 @@
+#ifndef DAEMON_CLIENT_H
+#define DAEMON_CLIENT_H
+
+#include "bios_types.h"
+#include "report.h"
+#include "config_daemon.h"
+
+// Blocking client for the config daemon. One request is in flight at a time;
+// use one client per thread.
+typedef struct {
+    int fd;
+    char last_error[REPORT_MESSAGE_LEN];    // Message from the last failed request
+    uint8_t buffer[sizeof(daemon_frame_t) + DAEMON_MAX_PAYLOAD];
+} daemon_client_t;
+
+// One row of a diff; presence is 1 (first only), 2 (second only) or 3 (both, values differ)
+typedef struct {
+    char name[MAX_SETTING_NAME];
+    uint8_t presence;
+    uint32_t first_value;
+    uint32_t second_value;
+} daemon_diff_entry_t;
+
+int connect_config_daemon(daemon_client_t *client, const char *socket_path);
+void disconnect_config_daemon(daemon_client_t *client);
+
+// Requests return the daemon's BIOS_* status, or BIOS_ERROR_FILE if the connection failed
+int daemon_open_config(daemon_client_t *client, const char *path, uint32_t *handle);
+int daemon_get_setting(daemon_client_t *client, uint32_t handle, const char *name, uint32_t *value);
+int daemon_set_setting(daemon_client_t *client, uint32_t handle, const char *name, uint32_t value);
+int daemon_validate_config(daemon_client_t *client, uint32_t handle, bios_report_t *report);
+int daemon_diff_configs(daemon_client_t *client, uint32_t first, uint32_t second,
+                        daemon_diff_entry_t *entries, int capacity, int *count);
+int daemon_save_config(daemon_client_t *client, uint32_t handle, const char *path);
+
+#endif // DAEMON_CLIENT_H
\ No newline at end of file
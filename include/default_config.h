@@ -0,0 +1,11 @@
+#ifndef DEFAULT_CONFIG_H
+#define DEFAULT_CONFIG_H
+
+#include "bios_types.h"
+
+// Default configuration as a constant image, built at compile time from
+// schema_settings.def with its checksum already filled in. The name index
+// is not part of the image; rebuild it after copying.
+const bios_config_t* get_default_config(void);
+
+#endif // DEFAULT_CONFIG_H
\ No newline at end of file
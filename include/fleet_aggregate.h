@@ -0,0 +1,69 @@
+#ifndef FLEET_AGGREGATE_H
+#define FLEET_AGGREGATE_H
+
+#include "bios_types.h"
+#include "fleet_loader.h"
+
+// Fleet-wide distributions of setting values.
+// An aggregate counts every distinct value of one setting, optionally grouped
+// by the (bucketed) value of another setting. Exact value counts make count,
+// min/max, mean, percentiles and histograms derivable at the end, and make two
+// aggregates mergeable by adding counts: each worker fills its own and they are
+// merged once at the end.
+#define AGGREGATE_MAX_STATS 16
+#define AGGREGATE_DEFAULT_BUCKETS 20
+
+typedef enum {
+    AGGREGATE_FORMAT_TEXT = 0,
+    AGGREGATE_FORMAT_JSON = 1
+} aggregate_format_t;
+
+// Exact value -> count map (open addressing)
+typedef struct {
+    uint32_t *values;
+    uint64_t *counts;           // 0 marks an empty slot
+    size_t slot_count;          // Power of two
+    size_t used;
+} value_counts_t;
+
+typedef struct {
+    uint32_t group;             // Lower bound of the group bucket (0 when ungrouped)
+    value_counts_t values;
+    uint64_t count;
+    uint32_t min;
+    uint32_t max;
+    double sum;
+} aggregate_group_t;
+
+typedef struct {
+    char setting[MAX_SETTING_NAME];
+    char group_by[MAX_SETTING_NAME];    // Empty: one group for the whole fleet
+    uint32_t group_width;               // Group bucket width, 1 = exact values
+    aggregate_group_t *groups;          // Sorted by group once finished
+    int group_count;
+    int group_capacity;
+    uint64_t missing;                   // Configs without the setting or the group setting
+    int setting_hint;                   // Where the settings were last found; configs
+    int group_hint;                     // of one fleet usually share a layout
+} aggregate_t;
+
+// Parse "SETTING" or "SETTING:GROUP_SETTING[/WIDTH]"
+int parse_aggregate_spec(const char *spec, aggregate_t *aggregate);
+void init_aggregate(aggregate_t *aggregate, const char *setting, const char *group_by, uint32_t group_width);
+void free_aggregate(aggregate_t *aggregate);
+
+// Accumulate and combine
+int aggregate_add_settings(aggregate_t *aggregate, const bios_setting_t *settings, int count);
+int aggregate_add_config(aggregate_t *aggregate, const bios_config_t *config);
+int merge_aggregate(aggregate_t *into, const aggregate_t *from);
+
+// Results
+uint32_t aggregate_percentile(const aggregate_group_t *group, double percentile);
+void print_aggregate(FILE *out, aggregate_t *aggregate, int histogram_buckets, aggregate_format_t format);
+
+// Stream every file through the aggregates on a work-stealing pool (thread_count <= 0: one per core).
+// Files that do not parse are counted in *failed_count.
+int aggregate_fleet(const fleet_paths_t *paths, int thread_count, aggregate_t *aggregates, int aggregate_count,
+                    size_t *failed_count);
+
+#endif // FLEET_AGGREGATE_H
\ No newline at end of file
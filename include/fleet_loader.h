@@ -0,0 +1,52 @@
+#ifndef FLEET_LOADER_H
+#define FLEET_LOADER_H
+
+#include "bios_types.h"
+#include "report.h"
+
+#define FLEET_PATH_MAX 260
+
+// List of configuration files to process
+typedef struct {
+    char **paths;
+    size_t count;
+    size_t capacity;
+} fleet_paths_t;
+
+// Outcome for one file
+typedef struct {
+    const char *path;            // Points into the fleet_paths_t
+    int parse_result;            // parse_bios_config_report() result
+    int checksum_ok;             // Stored checksum matched the settings
+    int validation_result;       // validate_all_settings() result
+    int setting_count;
+    bios_report_t report;        // Messages from parsing and validation
+} fleet_file_result_t;
+
+// Combined outcome for the whole fleet
+typedef struct {
+    fleet_file_result_t *files;  // One entry per path, in path order
+    size_t file_count;
+    size_t loaded_count;
+    size_t failed_count;
+    size_t checksum_error_count;
+    size_t invalid_count;
+    size_t warning_count;
+    size_t validations_run;      // Distinct settings payloads validated (once per worker)
+    size_t validations_cached;   // Files whose payload had already been validated
+} fleet_report_t;
+
+// Building the file list
+void init_fleet_paths(fleet_paths_t *paths);
+int add_fleet_path(fleet_paths_t *paths, const char *path);
+int collect_fleet_directory(fleet_paths_t *paths, const char *directory);
+int collect_fleet_list(fleet_paths_t *paths, const char *list_file);
+void free_fleet_paths(fleet_paths_t *paths);
+
+// Parse, checksum and validate every file on a work-stealing pool (thread_count <= 0: one per core).
+// Each worker validates through its own dedup store, so identical settings are validated once.
+int load_fleet(const fleet_paths_t *paths, int thread_count, fleet_report_t *report);
+void print_fleet_report(const fleet_report_t *report, int verbose);
+void free_fleet_report(fleet_report_t *report);
+
+#endif // FLEET_LOADER_H
\ No newline at end of file
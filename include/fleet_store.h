@@ -0,0 +1,63 @@
+#ifndef FLEET_STORE_H
+#define FLEET_STORE_H
+
+#include "bios_types.h"
+#include "config_view.h"
+
+#define FLEET_STORE_BLOCK_ROWS 4096  // Rows evaluated per query block
+
+// One setting across every stored config
+typedef struct {
+    char name[MAX_SETTING_NAME];     // Interned once per store
+    uint8_t type;                    // bios_data_type_t
+    uint32_t *values;                // One value per row, widened to 32 bits
+    uint8_t *present;                // 1 if the row's config has this setting
+} fleet_column_t;
+
+// Struct-of-arrays store holding the setting values of many configs
+typedef struct {
+    fleet_column_t *columns;
+    int column_count;
+    int column_capacity;
+    uint16_t *column_slots;          // Name hash -> column + 1, 0 = empty
+    size_t column_slot_count;
+    uint32_t *node_ids;              // Caller-supplied id per row
+    size_t row_count;
+    size_t row_capacity;
+} fleet_store_t;
+
+// Comparison operators
+typedef enum {
+    FLEET_OP_EQ = 0,
+    FLEET_OP_NE = 1,
+    FLEET_OP_LT = 2,
+    FLEET_OP_LE = 3,
+    FLEET_OP_GT = 4,
+    FLEET_OP_GE = 5
+} fleet_op_t;
+
+// "name op value"; rows without the setting never match
+typedef struct {
+    const char *name;
+    fleet_op_t op;
+    uint32_t value;
+} fleet_predicate_t;
+
+// Lifetime
+int init_fleet_store(fleet_store_t *store, size_t initial_rows);
+void free_fleet_store(fleet_store_t *store);
+
+// Loading
+int fleet_store_add_config(fleet_store_t *store, uint32_t node_id, const bios_config_t *config);
+int fleet_store_add_view(fleet_store_t *store, uint32_t node_id, const bios_config_view_t *view);
+int fleet_store_add_settings(fleet_store_t *store, uint32_t node_id, const bios_setting_t *settings, int count);
+int fleet_store_find_column(const fleet_store_t *store, const char *name);
+
+// Queries; all predicates must hold (AND)
+size_t fleet_store_filter(const fleet_store_t *store, const fleet_predicate_t *predicates, int predicate_count,
+                          uint8_t *row_mask);
+size_t fleet_store_count(const fleet_store_t *store, const fleet_predicate_t *predicates, int predicate_count);
+size_t fleet_store_select(const fleet_store_t *store, const fleet_predicate_t *predicates, int predicate_count,
+                          uint32_t *node_ids, size_t max_ids);
+
+#endif // FLEET_STORE_H
\ No newline at end of file
@@ -0,0 +1,15 @@
+#ifndef NAME_INDEX_H
+#define NAME_INDEX_H
+
+#include "bios_types.h"
+
+// Open-addressing hash index over the 32-byte setting names.
+// Each slot holds (setting position + 1); 0 marks an empty slot.
+// slot_count must be a power of two larger than the number of settings.
+
+uint32_t hash_setting_name(const char *name);
+void build_name_index(uint16_t *slots, size_t slot_count, const bios_setting_t *settings, int count);
+int insert_name_index(uint16_t *slots, size_t slot_count, const bios_setting_t *settings, int position);
+int lookup_name_index(const uint16_t *slots, size_t slot_count, const bios_setting_t *settings, const char *name);
+
+#endif // NAME_INDEX_H
\ No newline at end of file
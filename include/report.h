@@ -0,0 +1,30 @@
+#ifndef REPORT_H
+#define REPORT_H
+
+#include "bios_types.h"
+
+#define REPORT_MAX_MESSAGES 8
+#define REPORT_MESSAGE_LEN 96
+
+// Message severities
+typedef enum {
+    REPORT_ERROR = 0,
+    REPORT_WARNING = 1,
+    REPORT_INFO = 2
+} report_severity_t;
+
+// Per-call diagnostics collector.
+// Passing NULL wherever a report is accepted prints messages immediately instead.
+typedef struct {
+    int error_count;
+    int warning_count;
+    int message_count;                                      // Messages stored (capped)
+    char messages[REPORT_MAX_MESSAGES][REPORT_MESSAGE_LEN];
+} bios_report_t;
+
+void init_report(bios_report_t *report);
+void report_message(bios_report_t *report, report_severity_t severity, const char *format, ...)
+    __attribute__((format(printf, 3, 4)));
+void print_report(const bios_report_t *report);
+
+#endif // REPORT_H
\ No newline at end of file
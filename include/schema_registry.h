@@ -0,0 +1,32 @@
+#ifndef SCHEMA_REGISTRY_H
+#define SCHEMA_REGISTRY_H
+
+#include "bios_types.h"
+
+// Versioned registry of known settings, one row per setting in schema_settings.def.
+// IDs are permanent: new settings get new IDs and bump SCHEMA_VERSION,
+// existing entries are never renumbered or removed.
+#define SCHEMA_VERSION 1
+
+typedef struct {
+    uint16_t id;                // Stable setting ID, stored in compact files
+    uint16_t since_version;     // First schema version that defines it
+    const char *name;
+    bios_category_t category;
+    bios_data_type_t type;
+    uint32_t default_value;
+    uint32_t min_value;
+    uint32_t max_value;
+} schema_setting_t;
+
+// Registry access
+int schema_setting_count(void);
+const schema_setting_t* schema_get_setting(int index);
+const schema_setting_t* schema_find_by_id(uint16_t id);
+const schema_setting_t* schema_find_by_name(const char *name);
+
+// Build the full setting for a registry entry
+void init_schema_setting(bios_setting_t *setting, const schema_setting_t *definition, uint32_t value);
+int schema_setting_matches(const bios_setting_t *setting, const schema_setting_t *definition);
+
+#endif // SCHEMA_REGISTRY_H
\ No newline at end of file
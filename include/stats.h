@@ -0,0 +1,59 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include "bios_types.h"
+
+// Hot-path instrumentation.
+// Build with -DBIOS_STATS (make DEFINES=-DBIOS_STATS) to enable; otherwise the
+// STATS_* macros expand to nothing and the dump functions report "disabled".
+
+typedef enum {
+    STATS_FILE_OPEN = 0,
+    STATS_FILE_READ,
+    STATS_CHECKSUM,
+    STATS_LOOKUP,
+    STATS_VALIDATE,
+    STATS_SAVE,
+    STATS_PHASE_COUNT
+} stats_phase_t;
+
+typedef enum {
+    STATS_FORMAT_TEXT = 0,
+    STATS_FORMAT_JSON = 1
+} stats_format_t;
+
+// Totals for one phase, summed over all threads
+typedef struct {
+    uint64_t count;
+    uint64_t ticks;         // Timer ticks (TSC cycles on x86)
+    uint64_t max_ticks;     // Slowest single call
+    uint64_t bytes;
+} stats_phase_totals_t;
+
+typedef struct {
+    stats_phase_totals_t phases[STATS_PHASE_COUNT];
+    int thread_count;       // Threads that recorded anything
+    double ticks_per_ns;    // Timer frequency
+} stats_totals_t;
+
+typedef uint64_t stats_tick_t;
+
+#ifdef BIOS_STATS
+stats_tick_t stats_now(void);
+void stats_record(stats_phase_t phase, stats_tick_t start, uint64_t bytes);
+
+#define STATS_START(timer) stats_tick_t timer = stats_now()
+#define STATS_STOP(phase, timer, bytes) stats_record((phase), (timer), (bytes))
+#else
+#define STATS_START(timer)
+#define STATS_STOP(phase, timer, bytes)
+#endif
+
+// Reporting; available in every build
+int stats_enabled(void);
+void stats_collect(stats_totals_t *totals);
+void stats_reset(void);
+void stats_dump(FILE *out, stats_format_t format);
+const char* get_stats_phase_name(stats_phase_t phase);
+
+#endif // STATS_H
\ No newline at end of file
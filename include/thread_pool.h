@@ -0,0 +1,17 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include "bios_types.h"
+
+// Task callback: index is the task number, worker the calling worker (0..thread_count-1)
+typedef void (*thread_pool_task_fn)(void *context, size_t index, int worker);
+
+// Run task_count tasks on a work-stealing pool and wait for all of them.
+// Each worker starts with an equal share of the index range; idle workers
+// steal half of the remaining range from the busiest victim they find.
+// thread_count <= 0 sizes the pool to the number of cores.
+int run_thread_pool(size_t task_count, int thread_count, thread_pool_task_fn task, void *context);
+
+int get_cpu_count(void);
+
+#endif // THREAD_POOL_H
\ No newline at end of file
@@ -10,6 +10,16 @@ int validate_setting_value(const bios_setting_t *setting, const void *value);
 int validate_cpu_settings(const bios_config_t *config);
 int validate_memory_settings(const bios_config_t *config);
 int validate_boot_settings(const bios_config_t *config);
+int validate_all_settings(const bios_config_t *config, bios_report_t *report);
+int validate_settings_table(const bios_setting_t *settings, int count, bios_report_t *report);
+
+// Reentrant variants collecting messages in a report (NULL prints them)
+int validate_setting_report(const bios_setting_t *setting, bios_report_t *report);
+int validate_cpu_settings_report(const bios_config_t *config, bios_report_t *report);
+int validate_memory_settings_report(const bios_config_t *config, bios_report_t *report);
+int validate_boot_settings_report(const bios_config_t *config, bios_report_t *report);
+int detect_setting_conflicts_report(const bios_config_t *config, bios_report_t *report);
+int check_cpu_memory_compatibility_report(const bios_config_t *config, bios_report_t *report);
 
 // Safety checks
 int check_safe_cpu_frequency(uint32_t frequency);
@@ -23,5 +33,7 @@ int check_cpu_memory_compatibility(const bios_config_t *config);
 // Error reporting
 void report_validation_error(const char *setting_name, const char *error_message);
 void report_validation_warning(const char *setting_name, const char *warning_message);
+void record_validation_error(bios_report_t *report, const char *setting_name, const char *error_message);
+void record_validation_warning(bios_report_t *report, const char *setting_name, const char *warning_message);
 
 #endif // VALIDATOR_H
\ No newline at end of file
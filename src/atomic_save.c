@@ -0,0 +1,246 @@
+#include "../include/atomic_save.h"
+#include <stdatomic.h>
+
+#ifndef _WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define SAVE_PATH_MAX 260
+#define TEMP_NAME_ATTEMPTS 16
+
+// Distinguishes temp files of concurrent saves within one process
+static atomic_uint temp_sequence;
+
+static save_durability_t save_durability = SAVE_DURABILITY_FULL;
+
+void set_save_durability(save_durability_t durability) {
+    save_durability = durability;
+}
+
+save_durability_t get_save_durability(void) {
+    return save_durability;
+}
+
+// Directory part of a path, "." when there is none.
+// '\' separates only on Windows; on POSIX it is an ordinary file name character.
+static void get_parent_directory(const char *filename, char *directory, size_t size) {
+    const char *slash = strrchr(filename, '/');
+#ifdef _WIN32
+    const char *backslash = strrchr(filename, '\\');
+    if (backslash && (!slash || backslash > slash)) {
+        slash = backslash;
+    }
+#endif
+
+    if (!slash) {
+        snprintf(directory, size, ".");
+    } else if (slash == filename) {
+        snprintf(directory, size, "%c", *slash);
+    } else {
+        snprintf(directory, size, "%.*s", (int)(slash - filename), filename);
+    }
+}
+
+// Make a completed rename in directory durable
+static int sync_directory(const char *directory) {
+#ifdef _WIN32
+    // MoveFileEx with MOVEFILE_WRITE_THROUGH already flushed the rename
+    (void)directory;
+    return BIOS_SUCCESS;
+#else
+    int fd = open(directory, O_RDONLY);
+    if (fd < 0) {
+        return BIOS_ERROR_FILE;
+    }
+    int result = fsync(fd) == 0 ? BIOS_SUCCESS : BIOS_ERROR_FILE;
+    close(fd);
+    return result;
+#endif
+}
+
+// "<filename>.tmp<pid>.<sequence>", unique per call within the process
+static void make_temp_path(const char *filename, char *path, size_t size) {
+#ifdef _WIN32
+    unsigned long pid = GetCurrentProcessId();
+#else
+    unsigned long pid = (unsigned long)getpid();
+#endif
+    unsigned sequence = atomic_fetch_add(&temp_sequence, 1);
+    snprintf(path, size, "%s.tmp%lu.%u", filename, pid, sequence);
+}
+
+// Write the whole image to a newly created temp file next to filename, flushing it if the
+// durability level asks for it. Never opens an existing file: a name that is already taken
+// is retried with the next sequence number. On success path holds the temp file name.
+static int write_temp_file(const char *filename, char *path, size_t path_size, const void *data, size_t size) {
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    for (int attempt = 0; attempt < TEMP_NAME_ATTEMPTS && file == INVALID_HANDLE_VALUE; attempt++) {
+        make_temp_path(filename, path, path_size);
+        file = CreateFileA(path, GENERIC_WRITE, 0, NULL, CREATE_NEW, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file == INVALID_HANDLE_VALUE && GetLastError() != ERROR_FILE_EXISTS) {
+            return BIOS_ERROR_FILE;
+        }
+    }
+    if (file == INVALID_HANDLE_VALUE) {
+        return BIOS_ERROR_FILE;
+    }
+
+    DWORD written = 0;
+    int ok = WriteFile(file, data, (DWORD)size, &written, NULL) && written == size;
+    if (ok && save_durability >= SAVE_DURABILITY_DATA) {
+        ok = FlushFileBuffers(file);
+    }
+    ok = CloseHandle(file) && ok;
+    if (!ok) {
+        remove(path);
+    }
+    return ok ? BIOS_SUCCESS : BIOS_ERROR_FILE;
+#else
+    // Keep the permission bits of the file being replaced
+    struct stat existing;
+    int keep_mode = stat(filename, &existing) == 0 && S_ISREG(existing.st_mode);
+
+    int fd = -1;
+    for (int attempt = 0; attempt < TEMP_NAME_ATTEMPTS && fd < 0; attempt++) {
+        make_temp_path(filename, path, path_size);
+        fd = open(path, O_WRONLY | O_CREAT | O_EXCL, 0644);
+        if (fd < 0 && errno != EEXIST) {
+            return BIOS_ERROR_FILE;
+        }
+    }
+    if (fd < 0) {
+        return BIOS_ERROR_FILE;
+    }
+    if (keep_mode && fchmod(fd, existing.st_mode & 07777) != 0) {
+        close(fd);
+        remove(path);
+        return BIOS_ERROR_FILE;
+    }
+
+    const uint8_t *bytes = data;
+    size_t remaining = size;
+    while (remaining > 0) {
+        ssize_t written = write(fd, bytes, remaining);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            close(fd);
+            remove(path);
+            return BIOS_ERROR_FILE;
+        }
+        bytes += written;
+        remaining -= (size_t)written;
+    }
+
+    int ok = save_durability < SAVE_DURABILITY_DATA || fsync(fd) == 0;
+    ok = close(fd) == 0 && ok;
+    if (!ok) {
+        remove(path);
+    }
+    return ok ? BIOS_SUCCESS : BIOS_ERROR_FILE;
+#endif
+}
+
+static int replace_file(const char *temp_path, const char *filename) {
+#ifdef _WIN32
+    DWORD flags = MOVEFILE_REPLACE_EXISTING;
+    if (save_durability == SAVE_DURABILITY_FULL) {
+        flags |= MOVEFILE_WRITE_THROUGH;
+    }
+    return MoveFileExA(temp_path, filename, flags) ? BIOS_SUCCESS : BIOS_ERROR_FILE;
+#else
+    return rename(temp_path, filename) == 0 ? BIOS_SUCCESS : BIOS_ERROR_FILE;
+#endif
+}
+
+static int add_batch_directory(save_batch_t *batch, const char *directory) {
+    for (size_t i = 0; i < batch->count; i++) {
+        if (strcmp(batch->directories[i], directory) == 0) {
+            return BIOS_SUCCESS;
+        }
+    }
+
+    if (batch->count == batch->capacity) {
+        size_t capacity = batch->capacity ? batch->capacity * 2 : 8;
+        char **grown = realloc(batch->directories, capacity * sizeof(char*));
+        if (!grown) {
+            return BIOS_ERROR_FILE;
+        }
+        batch->directories = grown;
+        batch->capacity = capacity;
+    }
+
+    char *copy = malloc(strlen(directory) + 1);
+    if (!copy) {
+        return BIOS_ERROR_FILE;
+    }
+    strcpy(copy, directory);
+    batch->directories[batch->count++] = copy;
+    return BIOS_SUCCESS;
+}
+
+// Write to a fresh "<filename>.tmp<pid>.<sequence>", then rename over filename
+int write_file_atomic(const char *filename, const void *data, size_t size, save_batch_t *batch,
+                      bios_report_t *report) {
+    char temp_path[SAVE_PATH_MAX + 32];
+    if (strlen(filename) >= SAVE_PATH_MAX) {
+        report_message(report, REPORT_ERROR, "Error: Path too long: %s", filename);
+        return BIOS_ERROR_FILE;
+    }
+
+    if (write_temp_file(filename, temp_path, sizeof(temp_path), data, size) != BIOS_SUCCESS) {
+        report_message(report, REPORT_ERROR, "Error: Cannot write %s", filename);
+        return BIOS_ERROR_FILE;
+    }
+
+    if (replace_file(temp_path, filename) != BIOS_SUCCESS) {
+        remove(temp_path);
+        report_message(report, REPORT_ERROR, "Error: Cannot replace %s", filename);
+        return BIOS_ERROR_FILE;
+    }
+
+    if (save_durability < SAVE_DURABILITY_FULL) {
+        return BIOS_SUCCESS;
+    }
+
+    char directory[SAVE_PATH_MAX];
+    get_parent_directory(filename, directory, sizeof(directory));
+    if (batch) {
+        if (add_batch_directory(batch, directory) != BIOS_SUCCESS) {
+            report_message(report, REPORT_ERROR, "Error: Cannot queue directory flush for %s", filename);
+            return BIOS_ERROR_FILE;
+        }
+        return BIOS_SUCCESS;
+    }
+    if (sync_directory(directory) != BIOS_SUCCESS) {
+        report_message(report, REPORT_ERROR, "Error: Cannot flush directory %s", directory);
+        return BIOS_ERROR_FILE;
+    }
+    return BIOS_SUCCESS;
+}
+
+void init_save_batch(save_batch_t *batch) {
+    batch->directories = NULL;
+    batch->count = 0;
+    batch->capacity = 0;
+}
+
+// Flush every directory touched by the batch once, then release it
+int commit_save_batch(save_batch_t *batch, bios_report_t *report) {
+    int result = BIOS_SUCCESS;
+    for (size_t i = 0; i < batch->count; i++) {
+        if (sync_directory(batch->directories[i]) != BIOS_SUCCESS) {
+            report_message(report, REPORT_ERROR, "Error: Cannot flush directory %s", batch->directories[i]);
+            result = BIOS_ERROR_FILE;
+        }
+        free(batch->directories[i]);
+    }
+    free(batch->directories);
+    init_save_batch(batch);
+    return result;
+}
\ No newline at end of file
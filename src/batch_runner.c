@@ -0,0 +1,185 @@
+#include "../include/batch_runner.h"
+#include "../include/config_parser.h"
+#include "../include/config_cache.h"
+#include "../include/config_compact.h"
+#include "../include/validator.h"
+#include <stdarg.h>
+
+// Split off the next whitespace-separated word, in place
+static char* next_token(char **cursor) {
+    char *start = *cursor;
+    while (*start == ' ' || *start == '\t' || *start == '\r' || *start == '\n') {
+        start++;
+    }
+    if (*start == '\0') {
+        *cursor = start;
+        return NULL;
+    }
+
+    char *end = start;
+    while (*end && *end != ' ' && *end != '\t' && *end != '\r' && *end != '\n') {
+        end++;
+    }
+    if (*end) {
+        *end++ = '\0';
+    }
+    *cursor = end;
+    return start;
+}
+
+static void batch_error(batch_session_t *session, size_t line_number, const char *format, ...)
+    __attribute__((format(printf, 3, 4)));
+
+static void batch_error(batch_session_t *session, size_t line_number, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    session->error_count++;
+    fprintf(session->out, "Error: line %lu: ", (unsigned long)line_number);
+    vfprintf(session->out, format, args);
+    fprintf(session->out, "\n");
+    va_end(args);
+}
+
+static void print_batch_setting(FILE *out, const bios_setting_t *setting) {
+    fprintf(out, "%.*s=%u\n", MAX_SETTING_NAME, setting->name, get_setting_value(setting));
+}
+
+static void batch_set(batch_session_t *session, const char *name, const char *text, size_t line_number) {
+    const bios_setting_t *setting = find_setting(&session->config, name);
+    if (!setting) {
+        batch_error(session, line_number, "Unknown setting %s", name);
+        return;
+    }
+
+    uint32_t value;
+    if (parse_setting_text(setting, text, &value) != BIOS_SUCCESS) {
+        batch_error(session, line_number, "Invalid value %s", text);
+        return;
+    }
+
+    // Store in the setting's own width before range checking
+    uint8_t data[MAX_SETTING_DATA];
+    if (setting->type == BIOS_TYPE_STRING) {
+        batch_error(session, line_number, "Setting %s cannot be set", name);
+        return;
+    }
+    if (encode_setting_value(setting, value, data) != BIOS_SUCCESS ||
+        validate_setting_value(setting, data) != BIOS_SUCCESS) {
+        batch_error(session, line_number, "Value %s out of range", text);
+        return;
+    }
+    set_setting_by_name(&session->config, name, data);
+}
+
+int open_batch_session(batch_session_t *session, const char *config_path, FILE *out) {
+    memset(session, 0, sizeof(batch_session_t));
+    session->input_path = config_path;
+    session->out = out;
+
+    bios_report_t report;
+    init_report(&report);
+    int result = load_cached_config(config_path, &session->config, &report);
+    for (int i = 0; i < report.message_count; i++) {
+        fprintf(out, "%s\n", report.messages[i]);
+    }
+    return result;
+}
+
+// Apply one operation; problems are counted and reported, never fatal
+int run_batch_command(batch_session_t *session, char *line, size_t line_number) {
+    char *cursor = line;
+    char *command = next_token(&cursor);
+    if (!command || command[0] == '#') {
+        return BIOS_SUCCESS;
+    }
+
+    size_t errors_before = session->error_count;
+    char *first = next_token(&cursor);
+    char *second = first ? next_token(&cursor) : NULL;
+    char *extra = second ? next_token(&cursor) : NULL;
+    session->op_count++;
+
+    if (strcmp(command, "get") == 0 && first && !second) {
+        const bios_setting_t *setting = find_setting(&session->config, first);
+        if (setting) {
+            print_batch_setting(session->out, setting);
+        } else {
+            batch_error(session, line_number, "Unknown setting %s", first);
+        }
+    } else if (strcmp(command, "set") == 0 && second && !extra) {
+        batch_set(session, first, second, line_number);
+    } else if (strcmp(command, "list") == 0 && !first) {
+        for (int i = 0; i < session->config.setting_count; i++) {
+            print_batch_setting(session->out, &session->config.settings[i]);
+        }
+    } else if (strcmp(command, "validate") == 0 && !first) {
+        bios_report_t report;
+        init_report(&report);
+        if (validate_all_settings(&session->config, &report) == BIOS_SUCCESS) {
+            fprintf(session->out, "validate=ok warnings=%d\n", report.warning_count);
+        } else {
+            batch_error(session, line_number, "Validation failed");
+        }
+        for (int i = 0; i < report.message_count; i++) {
+            fprintf(session->out, "  %s\n", report.messages[i]);
+        }
+    } else if ((strcmp(command, "save") == 0 || strcmp(command, "compact") == 0) && !second) {
+        const char *path = first ? first : session->input_path;
+        if (strlen(path) >= sizeof(session->output_path)) {
+            batch_error(session, line_number, "Path too long: %s", path);
+        } else {
+            strcpy(session->output_path, path);
+            session->save_requested = 1;
+            session->save_compact = strcmp(command, "compact") == 0;
+        }
+    } else {
+        batch_error(session, line_number, "Cannot parse operation '%s'", command);
+    }
+
+    return session->error_count == errors_before ? BIOS_SUCCESS : BIOS_ERROR_INVALID_SETTING;
+}
+
+int run_batch_script(batch_session_t *session, FILE *script) {
+    char line[BATCH_LINE_MAX];
+    size_t line_number = 0;
+    size_t errors_before = session->error_count;
+
+    while (fgets(line, sizeof(line), script)) {
+        line_number++;
+        if (!strchr(line, '\n') && !feof(script)) {
+            // Discard the rest of an overlong line
+            int c;
+            while ((c = fgetc(script)) != EOF && c != '\n') {
+            }
+            batch_error(session, line_number, "Line longer than %d characters", BATCH_LINE_MAX - 2);
+            continue;
+        }
+        run_batch_command(session, line, line_number);
+    }
+    return session->error_count == errors_before ? BIOS_SUCCESS : BIOS_ERROR_INVALID_SETTING;
+}
+
+// Write the result once; a batch with failed operations is not saved
+int close_batch_session(batch_session_t *session) {
+    if (!session->save_requested) {
+        return session->error_count ? BIOS_ERROR_INVALID_SETTING : BIOS_SUCCESS;
+    }
+    if (session->error_count) {
+        fprintf(session->out, "Error: %lu of %lu operations failed, configuration not saved\n",
+                (unsigned long)session->error_count, (unsigned long)session->op_count);
+        return BIOS_ERROR_INVALID_SETTING;
+    }
+
+    bios_report_t report;
+    init_report(&report);
+    int result = session->save_compact
+                     ? save_bios_config_compact_report(session->output_path, &session->config, &report)
+                     : save_bios_config_report(session->output_path, &session->config, &report);
+    for (int i = 0; i < report.message_count; i++) {
+        fprintf(session->out, "%s\n", report.messages[i]);
+    }
+    if (result == BIOS_SUCCESS) {
+        fprintf(session->out, "Configuration saved to %s\n", session->output_path);
+    }
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,391 @@
+// Large file support must be requested before any system header
+#ifndef _WIN32
+#define _FILE_OFFSET_BITS 64
+#endif
+
+#include "../include/config_archive.h"
+#include "../include/config_parser.h"
+#include "../include/checksum.h"
+
+#ifdef _WIN32
+#define archive_seek(file, offset) _fseeki64((file), (__int64)(offset), SEEK_SET)
+#define archive_seek_end(file) _fseeki64((file), 0, SEEK_END)
+#define archive_tell(file) ((int64_t)_ftelli64(file))
+#else
+#define archive_seek(file, offset) fseeko((file), (off_t)(offset), SEEK_SET)
+#define archive_seek_end(file) fseeko((file), 0, SEEK_END)
+#define archive_tell(file) ((int64_t)ftello(file))
+#endif
+
+// Order entries by key, then by position so the latest duplicate sorts last
+static int compare_archive_entries(const void *a, const void *b) {
+    const bios_archive_entry_t *left = a;
+    const bios_archive_entry_t *right = b;
+    int order = memcmp(left->key, right->key, ARCHIVE_KEY_LEN);
+    if (order != 0) {
+        return order;
+    }
+    return (left->offset > right->offset) - (left->offset < right->offset);
+}
+
+// Keys are stored NUL-padded so they compare with a plain memcmp
+static int pack_archive_key(char key[ARCHIVE_KEY_LEN], const char *name) {
+    size_t length = strlen(name);
+    if (length == 0 || length >= ARCHIVE_KEY_LEN) {
+        return BIOS_ERROR_FORMAT;
+    }
+    memset(key, 0, ARCHIVE_KEY_LEN);
+    memcpy(key, name, length);
+    return BIOS_SUCCESS;
+}
+
+static int start_archive(const char *filename, bios_archive_writer_t *writer, uint16_t version) {
+    memset(writer, 0, sizeof(bios_archive_writer_t));
+    init_pack_dictionary(&writer->dictionary);
+    writer->packed = version == ARCHIVE_VERSION_PACKED;
+
+    writer->file = fopen(filename, "wb");
+    if (!writer->file) {
+        printf("Error: Cannot create file %s\n", filename);
+        return BIOS_ERROR_FILE;
+    }
+
+    bios_archive_header_t header = {0};
+    memcpy(header.signature, ARCHIVE_SIGNATURE, 4);
+    header.version = version;
+    if (fwrite(&header, sizeof(bios_archive_header_t), 1, writer->file) != 1) {
+        printf("Error: Cannot write archive header to %s\n", filename);
+        fclose(writer->file);
+        writer->file = NULL;
+        return BIOS_ERROR_FILE;
+    }
+
+    writer->position = sizeof(bios_archive_header_t);
+    return BIOS_SUCCESS;
+}
+
+int open_archive_writer(const char *filename, bios_archive_writer_t *writer) {
+    return start_archive(filename, writer, ARCHIVE_VERSION);
+}
+
+// Records are packed against a schema dictionary stored once in the archive
+int open_packed_archive_writer(const char *filename, bios_archive_writer_t *writer) {
+    return start_archive(filename, writer, ARCHIVE_VERSION_PACKED);
+}
+
+// Write one record as given; only its index entry is kept in memory
+static int write_archive_record(bios_archive_writer_t *writer, const char *key, const void *data, size_t size) {
+    if (writer->failed) {
+        return BIOS_ERROR_FILE;
+    }
+    if (writer->entry_count == writer->entry_capacity) {
+        size_t capacity = writer->entry_capacity ? writer->entry_capacity * 2 : 256;
+        bios_archive_entry_t *grown = realloc(writer->entries, capacity * sizeof(bios_archive_entry_t));
+        if (!grown) {
+            return BIOS_ERROR_FILE;
+        }
+        writer->entries = grown;
+        writer->entry_capacity = capacity;
+    }
+
+    bios_archive_entry_t *entry = &writer->entries[writer->entry_count];
+    if (pack_archive_key(entry->key, key) != BIOS_SUCCESS) {
+        printf("Error: Invalid archive key '%s'\n", key);
+        return BIOS_ERROR_FORMAT;
+    }
+    entry->offset = writer->position;
+    entry->length = size;
+    entry->crc32c = checksum_crc32c(0, data, size);
+    entry->reserved = 0;
+
+    if (fwrite(data, 1, size, writer->file) != size) {
+        printf("Error: Cannot write archive record %s\n", key);
+        writer->failed = 1;
+        return BIOS_ERROR_FILE;
+    }
+
+    writer->position += size;
+    writer->entry_count++;
+    return BIOS_SUCCESS;
+}
+
+// Append one configuration image, packing it first in packed archives
+int archive_append_record(bios_archive_writer_t *writer, const char *key, const void *data, size_t size) {
+    if (writer->failed) {
+        return BIOS_ERROR_FILE;
+    }
+    if (!writer->packed) {
+        return write_archive_record(writer, key, data, size);
+    }
+
+    uint8_t packed[MAX_PACKED_RECORD_SIZE];
+    size_t packed_size;
+    if (pack_config_image(&writer->dictionary, data, size, packed, sizeof(packed), &packed_size) != BIOS_SUCCESS) {
+        printf("Error: Cannot pack archive record %s\n", key);
+        return BIOS_ERROR_FORMAT;
+    }
+    return write_archive_record(writer, key, packed, packed_size);
+}
+
+int archive_append_config(bios_archive_writer_t *writer, const char *key, const bios_config_t *config) {
+    uint8_t image[MAX_CONFIG_IMAGE_SIZE(MAX_SETTINGS)];
+    size_t image_size;
+
+    int result = serialize_bios_config(config, image, sizeof(image), &image_size);
+    if (result != BIOS_SUCCESS) {
+        return result;
+    }
+    return archive_append_record(writer, key, image, image_size);
+}
+
+// Sort the index, drop superseded duplicates and write the footer.
+// A writer that already failed only closes the file: its offsets cannot be trusted.
+int close_archive_writer(bios_archive_writer_t *writer) {
+    int result = BIOS_SUCCESS;
+
+    qsort(writer->entries, writer->entry_count, sizeof(bios_archive_entry_t), compare_archive_entries);
+
+    size_t unique = 0;
+    for (size_t i = 0; i < writer->entry_count; i++) {
+        if (unique > 0 && memcmp(writer->entries[unique - 1].key, writer->entries[i].key, ARCHIVE_KEY_LEN) == 0) {
+            writer->entries[unique - 1] = writer->entries[i];
+        } else {
+            writer->entries[unique++] = writer->entries[i];
+        }
+    }
+
+    // Packed archives: the dictionary goes right before the index
+    bios_archive_dict_t dictionary = {0};
+    if (writer->packed && !writer->failed) {
+        dictionary.offset = writer->position;
+        dictionary.size = pack_dictionary_size(&writer->dictionary);
+        uint8_t *block = malloc((size_t)dictionary.size);
+        if (block) {
+            serialize_pack_dictionary(&writer->dictionary, block);
+            dictionary.crc32c = checksum_crc32c(0, block, (size_t)dictionary.size);
+        }
+        if (!block || fwrite(block, 1, (size_t)dictionary.size, writer->file) != dictionary.size) {
+            printf("Error: Cannot write archive dictionary\n");
+            writer->failed = 1;
+        } else {
+            writer->position += dictionary.size;
+        }
+        free(block);
+    }
+
+    bios_archive_trailer_t trailer = {0};
+    trailer.index_offset = writer->position;
+    trailer.entry_count = unique;
+    trailer.index_crc32c = checksum_crc32c(0, writer->entries, unique * sizeof(bios_archive_entry_t));
+    memcpy(trailer.magic, ARCHIVE_INDEX_MAGIC, 4);
+
+    if (writer->failed) {
+        result = BIOS_ERROR_FILE;
+    } else if (fwrite(writer->entries, sizeof(bios_archive_entry_t), unique, writer->file) != unique ||
+               (writer->packed && fwrite(&dictionary, sizeof(bios_archive_dict_t), 1, writer->file) != 1) ||
+               fwrite(&trailer, sizeof(bios_archive_trailer_t), 1, writer->file) != 1) {
+        printf("Error: Cannot write archive index\n");
+        result = BIOS_ERROR_FILE;
+    }
+    if (fclose(writer->file) != 0) {
+        result = BIOS_ERROR_FILE;
+    }
+
+    free(writer->entries);
+    free_pack_dictionary(&writer->dictionary);
+    memset(writer, 0, sizeof(bios_archive_writer_t));
+    return result;
+}
+
+// Open an archive and load its index
+int open_archive(const char *filename, bios_archive_t *archive) {
+    memset(archive, 0, sizeof(bios_archive_t));
+    init_pack_dictionary(&archive->dictionary);
+
+    archive->file = fopen(filename, "rb");
+    if (!archive->file) {
+        printf("Error: Cannot open file %s\n", filename);
+        return BIOS_ERROR_FILE;
+    }
+
+    bios_archive_header_t header;
+    if (fread(&header, sizeof(bios_archive_header_t), 1, archive->file) != 1 ||
+        memcmp(header.signature, ARCHIVE_SIGNATURE, 4) != 0 ||
+        (header.version != ARCHIVE_VERSION && header.version != ARCHIVE_VERSION_PACKED)) {
+        printf("Error: %s is not a configuration archive\n", filename);
+        close_archive(archive);
+        return BIOS_ERROR_FORMAT;
+    }
+
+    // The trailer sits at the very end of the file
+    bios_archive_trailer_t trailer;
+    int64_t end = archive_seek_end(archive->file) == 0 ? archive_tell(archive->file) : -1;
+    if (end < (int64_t)(sizeof(bios_archive_header_t) + sizeof(bios_archive_trailer_t)) ||
+        archive_seek(archive->file, end - (int64_t)sizeof(bios_archive_trailer_t)) != 0 ||
+        fread(&trailer, sizeof(bios_archive_trailer_t), 1, archive->file) != 1 ||
+        memcmp(trailer.magic, ARCHIVE_INDEX_MAGIC, 4) != 0) {
+        printf("Error: Archive %s has no index (incomplete write?)\n", filename);
+        close_archive(archive);
+        return BIOS_ERROR_FORMAT;
+    }
+    archive->file_size = (uint64_t)end;
+    archive->packed = header.version == ARCHIVE_VERSION_PACKED;
+
+    // The index must fit exactly between the records and the trailer (or dictionary locator)
+    uint64_t index_end = archive->file_size - sizeof(bios_archive_trailer_t);
+    bios_archive_dict_t dictionary = {0};
+    if (archive->packed) {
+        if (index_end < sizeof(bios_archive_header_t) + sizeof(bios_archive_dict_t) ||
+            archive_seek(archive->file, index_end - sizeof(bios_archive_dict_t)) != 0 ||
+            fread(&dictionary, sizeof(bios_archive_dict_t), 1, archive->file) != 1) {
+            printf("Error: Archive %s has no dictionary\n", filename);
+            close_archive(archive);
+            return BIOS_ERROR_FORMAT;
+        }
+        index_end -= sizeof(bios_archive_dict_t);
+    }
+    if (trailer.index_offset < sizeof(bios_archive_header_t) || trailer.index_offset > index_end ||
+        trailer.entry_count != (index_end - trailer.index_offset) / sizeof(bios_archive_entry_t)) {
+        printf("Error: Archive %s has an inconsistent index\n", filename);
+        close_archive(archive);
+        return BIOS_ERROR_FORMAT;
+    }
+
+    archive->entry_count = (size_t)trailer.entry_count;
+    archive->entries = malloc(archive->entry_count ? archive->entry_count * sizeof(bios_archive_entry_t) : 1);
+    if (!archive->entries ||
+        archive_seek(archive->file, trailer.index_offset) != 0 ||
+        fread(archive->entries, sizeof(bios_archive_entry_t), archive->entry_count, archive->file) !=
+            archive->entry_count) {
+        printf("Error: Cannot read archive index from %s\n", filename);
+        close_archive(archive);
+        return BIOS_ERROR_FILE;
+    }
+
+    if (checksum_crc32c(0, archive->entries, archive->entry_count * sizeof(bios_archive_entry_t)) !=
+        trailer.index_crc32c) {
+        printf("Error: Archive index checksum mismatch in %s\n", filename);
+        close_archive(archive);
+        return BIOS_ERROR_CHECKSUM;
+    }
+
+    if (archive->packed) {
+        // The dictionary must end where the index starts
+        uint8_t *block = NULL;
+        int result = BIOS_ERROR_FORMAT;
+        if (dictionary.offset + dictionary.size == trailer.index_offset &&
+            dictionary.offset >= sizeof(bios_archive_header_t) &&
+            (block = malloc(dictionary.size ? (size_t)dictionary.size : 1)) != NULL &&
+            archive_seek(archive->file, dictionary.offset) == 0 &&
+            fread(block, 1, (size_t)dictionary.size, archive->file) == dictionary.size) {
+            result = checksum_crc32c(0, block, (size_t)dictionary.size) == dictionary.crc32c
+                         ? load_pack_dictionary(&archive->dictionary, block, (size_t)dictionary.size)
+                         : BIOS_ERROR_CHECKSUM;
+        }
+        free(block);
+        if (result != BIOS_SUCCESS) {
+            printf("Error: Cannot read archive dictionary from %s\n", filename);
+            close_archive(archive);
+            return result;
+        }
+    }
+
+    return BIOS_SUCCESS;
+}
+
+void close_archive(bios_archive_t *archive) {
+    if (archive->file) {
+        fclose(archive->file);
+    }
+    free(archive->entries);
+    free_pack_dictionary(&archive->dictionary);
+    memset(archive, 0, sizeof(bios_archive_t));
+}
+
+// Binary search over the sorted index
+const bios_archive_entry_t* archive_find(const bios_archive_t *archive, const char *key) {
+    char packed[ARCHIVE_KEY_LEN];
+    if (pack_archive_key(packed, key) != BIOS_SUCCESS) {
+        return NULL;
+    }
+
+    size_t low = 0;
+    size_t high = archive->entry_count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        int order = memcmp(archive->entries[mid].key, packed, ARCHIVE_KEY_LEN);
+        if (order == 0) {
+            return &archive->entries[mid];
+        }
+        if (order < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return NULL;
+}
+
+// Entries in key order, for sequential iteration
+const bios_archive_entry_t* archive_get_entry(const bios_archive_t *archive, size_t index) {
+    if (index >= archive->entry_count) {
+        return NULL;
+    }
+    return &archive->entries[index];
+}
+
+// Read one record and verify it against its index entry
+int archive_read_record(const bios_archive_t *archive, const bios_archive_entry_t *entry,
+                        void *buffer, size_t capacity) {
+    if (entry->length > capacity || entry->offset + entry->length > archive->file_size) {
+        return BIOS_ERROR_FORMAT;
+    }
+    if (archive_seek(archive->file, entry->offset) != 0 ||
+        fread(buffer, 1, (size_t)entry->length, archive->file) != entry->length) {
+        return BIOS_ERROR_FILE;
+    }
+    if (checksum_crc32c(0, buffer, (size_t)entry->length) != entry->crc32c) {
+        return BIOS_ERROR_CHECKSUM;
+    }
+    return BIOS_SUCCESS;
+}
+
+// Read one record as a configuration image, unpacking it if necessary
+int archive_read_image(const bios_archive_t *archive, const bios_archive_entry_t *entry,
+                       uint8_t *image, size_t capacity, size_t *image_size) {
+    if (!archive->packed) {
+        int result = archive_read_record(archive, entry, image, capacity);
+        *image_size = (size_t)entry->length;
+        return result;
+    }
+
+    uint8_t packed[MAX_PACKED_RECORD_SIZE];
+    int result = archive_read_record(archive, entry, packed, sizeof(packed));
+    if (result != BIOS_SUCCESS) {
+        return result;
+    }
+    return unpack_config_image(&archive->dictionary, packed, (size_t)entry->length, image, capacity, image_size);
+}
+
+int archive_load_config(const bios_archive_t *archive, const char *key, bios_config_t *config,
+                        bios_report_t *report) {
+    const bios_archive_entry_t *entry = archive_find(archive, key);
+    if (!entry) {
+        report_message(report, REPORT_ERROR, "Error: Record '%s' not found in archive", key);
+        return BIOS_ERROR_INVALID_SETTING;
+    }
+
+    uint8_t image[MAX_CONFIG_IMAGE_SIZE(MAX_SETTINGS)];
+    size_t image_size;
+    int result = archive_read_image(archive, entry, image, sizeof(image), &image_size);
+    if (result == BIOS_ERROR_CHECKSUM) {
+        report_message(report, REPORT_ERROR, "Error: Archive record '%s' is corrupted", key);
+        return result;
+    }
+    if (result != BIOS_SUCCESS) {
+        report_message(report, REPORT_ERROR, "Error: Cannot read archive record '%s'", key);
+        return result;
+    }
+
+    return parse_bios_config_image(image, image_size, config, report);
+}
\ No newline at end of file
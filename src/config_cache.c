@@ -0,0 +1,337 @@
+#include "../include/config_cache.h"
+#include "../include/config_parser.h"
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <sys/stat.h>
+#endif
+
+#define CACHE_BUCKETS 1024          // Power of two
+
+// Identity of one version of a file
+typedef struct {
+    uint64_t device;
+    uint64_t inode;
+    uint64_t mtime;             // Nanoseconds (POSIX) or 100 ns ticks (Windows)
+    uint64_t size;
+} cache_key_t;
+
+typedef struct cache_entry {
+    bios_config_t config;       // First, so a config pointer leads back to its entry
+    bios_report_t parse_report; // Messages from the parse, replayed on hits
+    cache_key_t key;
+    char *path;
+    size_t bytes;
+    int ref_count;
+    int detached;               // No longer findable; freed on the last release
+    struct cache_entry *bucket_next;
+    struct cache_entry *lru_prev;   // Most recently used at lru_head
+    struct cache_entry *lru_next;
+} cache_entry_t;
+
+static cache_entry_t *buckets[CACHE_BUCKETS];
+static cache_entry_t *lru_head;
+static cache_entry_t *lru_tail;
+static config_cache_stats_t cache_stats = { .budget = CONFIG_CACHE_DEFAULT_BUDGET };
+
+#ifdef _WIN32
+static INIT_ONCE cache_once = INIT_ONCE_STATIC_INIT;
+static CRITICAL_SECTION cache_lock;
+
+static BOOL CALLBACK init_cache_lock(PINIT_ONCE once, PVOID parameter, PVOID *context) {
+    (void)once;
+    (void)parameter;
+    (void)context;
+    InitializeCriticalSection(&cache_lock);
+    return TRUE;
+}
+
+static void lock_cache(void) {
+    InitOnceExecuteOnce(&cache_once, init_cache_lock, NULL, NULL);
+    EnterCriticalSection(&cache_lock);
+}
+
+static void unlock_cache(void) {
+    LeaveCriticalSection(&cache_lock);
+}
+#else
+static pthread_mutex_t cache_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void lock_cache(void) {
+    pthread_mutex_lock(&cache_lock);
+}
+
+static void unlock_cache(void) {
+    pthread_mutex_unlock(&cache_lock);
+}
+#endif
+
+static int read_cache_key(const char *filename, cache_key_t *key) {
+    memset(key, 0, sizeof(cache_key_t));
+#ifdef _WIN32
+    HANDLE handle = CreateFileA(filename, FILE_READ_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return BIOS_ERROR_FILE;
+    }
+    BY_HANDLE_FILE_INFORMATION info;
+    BOOL ok = GetFileInformationByHandle(handle, &info);
+    CloseHandle(handle);
+    if (!ok) {
+        return BIOS_ERROR_FILE;
+    }
+    key->device = info.dwVolumeSerialNumber;
+    key->inode = ((uint64_t)info.nFileIndexHigh << 32) | info.nFileIndexLow;
+    key->mtime = ((uint64_t)info.ftLastWriteTime.dwHighDateTime << 32) | info.ftLastWriteTime.dwLowDateTime;
+    key->size = ((uint64_t)info.nFileSizeHigh << 32) | info.nFileSizeLow;
+#else
+    struct stat info;
+    if (stat(filename, &info) != 0) {
+        return BIOS_ERROR_FILE;
+    }
+    key->device = (uint64_t)info.st_dev;
+    key->inode = (uint64_t)info.st_ino;
+    // Whole seconds would miss a rewrite of the same size within one second
+#ifdef __APPLE__
+    key->mtime = (uint64_t)info.st_mtimespec.tv_sec * 1000000000u + (uint64_t)info.st_mtimespec.tv_nsec;
+#else
+    key->mtime = (uint64_t)info.st_mtim.tv_sec * 1000000000u + (uint64_t)info.st_mtim.tv_nsec;    // POSIX.1-2008
+#endif
+    key->size = (uint64_t)info.st_size;
+#endif
+    return BIOS_SUCCESS;
+}
+
+static int same_cache_key(const cache_key_t *a, const cache_key_t *b) {
+    return a->device == b->device && a->inode == b->inode && a->mtime == b->mtime && a->size == b->size;
+}
+
+// FNV-1a over the path as given
+static uint32_t hash_path(const char *path) {
+    uint32_t hash = 2166136261u;
+    for (const unsigned char *p = (const unsigned char*)path; *p; p++) {
+        hash = (hash ^ *p) * 16777619u;
+    }
+    return hash;
+}
+
+static cache_entry_t* find_entry(const char *path) {
+    for (cache_entry_t *entry = buckets[hash_path(path) & (CACHE_BUCKETS - 1)]; entry; entry = entry->bucket_next) {
+        if (strcmp(entry->path, path) == 0) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static void lru_unlink(cache_entry_t *entry) {
+    if (entry->lru_prev) {
+        entry->lru_prev->lru_next = entry->lru_next;
+    } else {
+        lru_head = entry->lru_next;
+    }
+    if (entry->lru_next) {
+        entry->lru_next->lru_prev = entry->lru_prev;
+    } else {
+        lru_tail = entry->lru_prev;
+    }
+    entry->lru_prev = entry->lru_next = NULL;
+}
+
+static void lru_push_front(cache_entry_t *entry) {
+    entry->lru_prev = NULL;
+    entry->lru_next = lru_head;
+    if (lru_head) {
+        lru_head->lru_prev = entry;
+    } else {
+        lru_tail = entry;
+    }
+    lru_head = entry;
+}
+
+static void free_entry(cache_entry_t *entry) {
+    free(entry->path);
+    free(entry);
+}
+
+// Remove from lookup and LRU order; the memory goes once nobody holds it
+static void detach_entry(cache_entry_t *entry) {
+    cache_entry_t **link = &buckets[hash_path(entry->path) & (CACHE_BUCKETS - 1)];
+    while (*link != entry) {
+        link = &(*link)->bucket_next;
+    }
+    *link = entry->bucket_next;
+    lru_unlink(entry);
+    entry->detached = 1;
+    cache_stats.entry_count--;
+    cache_stats.bytes_used -= entry->bytes;
+    if (entry->ref_count == 0) {
+        free_entry(entry);
+    }
+}
+
+// Drop least recently used entries nobody holds until within the budget
+static void enforce_budget(void) {
+    cache_entry_t *entry = lru_tail;
+    while (entry && cache_stats.bytes_used > cache_stats.budget) {
+        cache_entry_t *previous = entry->lru_prev;
+        if (entry->ref_count == 0) {
+            detach_entry(entry);
+            cache_stats.evictions++;
+        }
+        entry = previous;
+    }
+}
+
+// Stored messages keep the "Error: " / "Warning: " prefix, which gives back their severity
+static void replay_parse_report(const bios_report_t *parse_report, bios_report_t *report) {
+    for (int i = 0; i < parse_report->message_count; i++) {
+        const char *message = parse_report->messages[i];
+        report_message(report, strncmp(message, "Error", 5) == 0 ? REPORT_ERROR : REPORT_WARNING, "%s", message);
+    }
+}
+
+void set_config_cache_budget(size_t bytes) {
+    lock_cache();
+    cache_stats.budget = bytes;
+    enforce_budget();
+    unlock_cache();
+}
+
+int acquire_cached_config(const char *filename, const bios_config_t **config, bios_report_t *report) {
+    *config = NULL;
+
+    cache_key_t key;
+    if (read_cache_key(filename, &key) != BIOS_SUCCESS) {
+        report_message(report, REPORT_ERROR, "Error: Cannot open file %s", filename);
+        return BIOS_ERROR_FILE;
+    }
+
+    lock_cache();
+    cache_entry_t *entry = find_entry(filename);
+    if (entry && !same_cache_key(&entry->key, &key)) {
+        detach_entry(entry);
+        cache_stats.invalidations++;
+        entry = NULL;
+    }
+    if (entry) {
+        entry->ref_count++;
+        lru_unlink(entry);
+        lru_push_front(entry);
+        cache_stats.hits++;
+        unlock_cache();
+        replay_parse_report(&entry->parse_report, report);
+        report_message(report, REPORT_INFO, "Successfully loaded configuration: %d settings (cached)",
+                       entry->config.setting_count);
+        *config = &entry->config;
+        return BIOS_SUCCESS;
+    }
+    cache_stats.misses++;
+    unlock_cache();
+
+    // Parse outside the lock so other files load in parallel
+    size_t path_length = strlen(filename) + 1;
+    entry = calloc(1, sizeof(cache_entry_t));
+    char *path = malloc(path_length);
+    if (!entry || !path) {
+        free(entry);
+        free(path);
+        report_message(report, REPORT_ERROR, "Error: Cannot allocate cache entry for %s", filename);
+        return BIOS_ERROR_FILE;
+    }
+    memcpy(path, filename, path_length);
+    entry->path = path;
+    entry->bytes = sizeof(cache_entry_t) + path_length;
+    entry->key = key;
+    entry->ref_count = 1;
+
+    init_report(&entry->parse_report);
+    int result = parse_bios_config_report(filename, &entry->config, &entry->parse_report);
+    replay_parse_report(&entry->parse_report, report);
+    if (result != BIOS_SUCCESS) {
+        free_entry(entry);
+        return result;
+    }
+
+    // A file that changed while it was read is handed out but not kept
+    cache_key_t after;
+    lock_cache();
+    if (read_cache_key(filename, &after) != BIOS_SUCCESS || !same_cache_key(&key, &after)) {
+        entry->detached = 1;
+    } else {
+        cache_entry_t *existing = find_entry(filename);
+        if (existing) {
+            // Another thread loaded it meanwhile; the newer parse replaces it
+            detach_entry(existing);
+        }
+        uint32_t bucket = hash_path(filename) & (CACHE_BUCKETS - 1);
+        entry->bucket_next = buckets[bucket];
+        buckets[bucket] = entry;
+        lru_push_front(entry);
+        cache_stats.entry_count++;
+        cache_stats.bytes_used += entry->bytes;
+        enforce_budget();
+    }
+    unlock_cache();
+
+    report_message(report, REPORT_INFO, "Successfully loaded configuration: %d settings", entry->config.setting_count);
+    *config = &entry->config;
+    return BIOS_SUCCESS;
+}
+
+void release_cached_config(const bios_config_t *config) {
+    if (!config) {
+        return;
+    }
+    cache_entry_t *entry = (cache_entry_t*)config;
+
+    lock_cache();
+    entry->ref_count--;
+    if (entry->ref_count == 0) {
+        if (entry->detached) {
+            free_entry(entry);
+        } else {
+            enforce_budget();
+        }
+    }
+    unlock_cache();
+}
+
+int load_cached_config(const char *filename, bios_config_t *config, bios_report_t *report) {
+    const bios_config_t *shared;
+    int result = acquire_cached_config(filename, &shared, report);
+    if (result != BIOS_SUCCESS) {
+        return result;
+    }
+    *config = *shared;
+    release_cached_config(shared);
+    return BIOS_SUCCESS;
+}
+
+void get_config_cache_stats(config_cache_stats_t *stats) {
+    lock_cache();
+    *stats = cache_stats;
+    unlock_cache();
+}
+
+void print_config_cache_stats(void) {
+    config_cache_stats_t stats;
+    get_config_cache_stats(&stats);
+
+    size_t lookups = stats.hits + stats.misses;
+    printf("Config cache: %lu hits, %lu misses (%.1f%% hit rate), %lu entries, %lu / %lu bytes, "
+           "%lu evicted, %lu invalidated\n",
+           (unsigned long)stats.hits, (unsigned long)stats.misses,
+           lookups ? 100.0 * (double)stats.hits / (double)lookups : 0.0,
+           (unsigned long)stats.entry_count, (unsigned long)stats.bytes_used, (unsigned long)stats.budget,
+           (unsigned long)stats.evictions, (unsigned long)stats.invalidations);
+}
+
+// Drop every entry nobody holds; held entries go on their last release
+void clear_config_cache(void) {
+    lock_cache();
+    while (lru_head) {
+        detach_entry(lru_head);
+    }
+    unlock_cache();
+}
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include "../include/config_compact.h"
+#include "../include/config_parser.h"
+#include "../include/schema_registry.h"
+#include "../include/stats.h"
+
+// Header plus (ID, value) pairs; fails if a setting is not exactly its registry entry
+int serialize_compact_image(const bios_config_t *config, uint8_t *buffer, size_t capacity, size_t *image_size,
+                            bios_report_t *report) {
+    if (capacity < sizeof(bios_config_header_t)) {
+        return BIOS_ERROR_FORMAT;
+    }
+
+    size_t offset = sizeof(bios_config_header_t);
+    for (int i = 0; i < config->setting_count; i++) {
+        const bios_setting_t *setting = &config->settings[i];
+        const schema_setting_t *definition = schema_find_by_name(setting->name);
+        if (!definition || !schema_setting_matches(setting, definition)) {
+            report_message(report, REPORT_ERROR, "Error: Setting %.*s is not in schema version %d",
+                           MAX_SETTING_NAME, setting->name, SCHEMA_VERSION);
+            return BIOS_ERROR_INVALID_SETTING;
+        }
+        if (offset + sizeof(uint16_t) + setting->size > capacity) {
+            return BIOS_ERROR_FORMAT;
+        }
+        memcpy(buffer + offset, &definition->id, sizeof(uint16_t));
+        memcpy(buffer + offset + sizeof(uint16_t), setting->data, setting->size);
+        offset += sizeof(uint16_t) + setting->size;
+    }
+
+    bios_config_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.signature, BIOS_SIGNATURE, 4);
+    header.version = BIOS_VERSION_COMPACT;
+    header.num_settings = config->setting_count;
+    header.data_size = (uint32_t)(offset - sizeof(bios_config_header_t));
+    header.checksum = calculate_checksum(config);
+    header.reserved = SCHEMA_VERSION;
+    memcpy(buffer, &header, sizeof(header));
+
+    *image_size = offset;
+    return BIOS_SUCCESS;
+}
+
+int save_bios_config_compact(const char *filename, const bios_config_t *config) {
+    return save_bios_config_compact_report(filename, config, NULL);
+}
+
+int save_bios_config_compact_report(const char *filename, const bios_config_t *config, bios_report_t *report) {
+    STATS_START(save_timer);
+    uint8_t image[sizeof(bios_config_header_t) + MAX_COMPACT_PAYLOAD(MAX_SETTINGS)];
+    size_t image_size;
+
+    int result = serialize_compact_image(config, image, sizeof(image), &image_size, report);
+    if (result == BIOS_SUCCESS) {
+        result = write_file_atomic(filename, image, image_size, NULL, report);
+    }
+    if (result != BIOS_SUCCESS) {
+        return result;
+    }
+
+    STATS_STOP(STATS_SAVE, save_timer, image_size);
+    report_message(report, REPORT_INFO, "Configuration saved to %s (compact, %lu bytes)",
+                   filename, (unsigned long)image_size);
+    return BIOS_SUCCESS;
+}
+
+// Rebuild full settings from (ID, value) pairs
+int expand_compact_settings(bios_config_header_t *header, const uint8_t *payload,
+                            bios_setting_t *settings, int capacity, bios_report_t *report) {
+    if (header->reserved > SCHEMA_VERSION) {
+        report_message(report, REPORT_ERROR, "Error: Schema version %d is newer than supported (%d)",
+                       header->reserved, SCHEMA_VERSION);
+        return BIOS_ERROR_FORMAT;
+    }
+    if (header->num_settings > capacity) {
+        report_message(report, REPORT_ERROR, "Error: Too many settings (%d > %d)", header->num_settings, capacity);
+        return BIOS_ERROR_FORMAT;
+    }
+
+    size_t offset = 0;
+    for (int i = 0; i < header->num_settings; i++) {
+        uint16_t id;
+        if (offset + sizeof(id) > header->data_size) {
+            report_message(report, REPORT_ERROR, "Error: Compact data ends after %d of %d settings",
+                           i, header->num_settings);
+            return BIOS_ERROR_FORMAT;
+        }
+        memcpy(&id, payload + offset, sizeof(id));
+        offset += sizeof(id);
+
+        const schema_setting_t *definition = schema_find_by_id(id);
+        if (!definition || definition->since_version > header->reserved) {
+            report_message(report, REPORT_ERROR, "Error: Unknown setting ID %u in schema version %d",
+                           id, header->reserved);
+            return BIOS_ERROR_FORMAT;
+        }
+
+        // Value bytes are copied as stored, so out-of-range values survive for validation
+        init_schema_setting(&settings[i], definition, 0);
+        if (offset + settings[i].size > header->data_size) {
+            report_message(report, REPORT_ERROR, "Error: Compact data ends inside %s", definition->name);
+            return BIOS_ERROR_FORMAT;
+        }
+        memcpy(settings[i].data, payload + offset, settings[i].size);
+        offset += settings[i].size;
+    }
+
+    if (offset != header->data_size) {
+        report_message(report, REPORT_ERROR, "Error: %lu unexpected bytes after compact settings",
+                       (unsigned long)(header->data_size - offset));
+        return BIOS_ERROR_FORMAT;
+    }
+
+    // The stored checksum already covers the expanded settings
+    header->version = BIOS_VERSION;
+    header->data_size = sizeof(bios_setting_t) * header->num_settings;
+    header->reserved = 0;
+    return BIOS_SUCCESS;
+}
+
+int read_compact_settings(FILE *file, const char *filename, bios_config_header_t *header,
+                          bios_setting_t *settings, int capacity, bios_report_t *report) {
+    if (header->data_size > MAX_COMPACT_PAYLOAD(capacity)) {
+        report_message(report, REPORT_ERROR, "Error: Compact data in %s is too large", filename);
+        return BIOS_ERROR_FORMAT;
+    }
+
+    uint8_t stack_payload[MAX_COMPACT_PAYLOAD(MAX_SETTINGS)];
+    uint8_t *payload = header->data_size <= sizeof(stack_payload) ? stack_payload : malloc(header->data_size);
+    if (!payload) {
+        report_message(report, REPORT_ERROR, "Error: Cannot allocate %lu bytes", (unsigned long)header->data_size);
+        return BIOS_ERROR_FORMAT;
+    }
+
+    int result;
+    if (fread(payload, 1, header->data_size, file) != header->data_size) {
+        report_message(report, REPORT_ERROR, "Error: Cannot read settings from %s", filename);
+        result = BIOS_ERROR_FORMAT;
+    } else {
+        result = expand_compact_settings(header, payload, settings, capacity, report);
+    }
+
+    if (payload != stack_payload) {
+        free(payload);
+    }
+    return result;
+}
\ No newline at end of file
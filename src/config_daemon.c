@@ -0,0 +1,622 @@
+// accept4 must be requested before any system header
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+#include "../include/config_daemon.h"
+#include "../include/config_parser.h"
+#include "../include/config_cache.h"
+#include "../include/validator.h"
+
+#ifdef __linux__
+#include <errno.h>
+#include <stdarg.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#define DAEMON_MAX_EVENTS 64
+#define DAEMON_FRAME_MAX (sizeof(daemon_frame_t) + DAEMON_MAX_PAYLOAD)
+#define DAEMON_OUTPUT_HIGH_WATER (1 << 20)     // Stop reading from a client that does not collect its responses
+
+struct daemon_connection {
+    int fd;
+    uint32_t events;                // Registered with epoll
+    uint8_t input[DAEMON_FRAME_MAX];
+    size_t input_used;
+    uint8_t *output;
+    size_t output_used;
+    size_t output_sent;
+    size_t output_capacity;
+    daemon_connection_t *prev;
+    daemon_connection_t *next;
+};
+
+// Response under construction
+typedef struct {
+    int16_t status;
+    uint32_t length;
+    uint8_t payload[DAEMON_MAX_PAYLOAD];
+} daemon_response_t;
+
+static void put_u16(daemon_response_t *response, uint16_t value) {
+    memcpy(response->payload + response->length, &value, sizeof(value));
+    response->length += sizeof(value);
+}
+
+static void put_u32(daemon_response_t *response, uint32_t value) {
+    memcpy(response->payload + response->length, &value, sizeof(value));
+    response->length += sizeof(value);
+}
+
+static void fail_response(daemon_response_t *response, int status, const char *format, ...)
+    __attribute__((format(printf, 3, 4)));
+
+static void fail_response(daemon_response_t *response, int status, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf((char*)response->payload, DAEMON_MAX_PAYLOAD, format, args);
+    va_end(args);
+    response->status = (int16_t)status;
+    response->length = written < 0 ? 0 : (uint32_t)(written < DAEMON_MAX_PAYLOAD ? written : DAEMON_MAX_PAYLOAD - 1);
+}
+
+// Request fields
+
+static int take_u32(const uint8_t **payload, uint32_t *remaining, uint32_t *value) {
+    if (*remaining < sizeof(uint32_t)) {
+        return 0;
+    }
+    memcpy(value, *payload, sizeof(uint32_t));
+    *payload += sizeof(uint32_t);
+    *remaining -= sizeof(uint32_t);
+    return 1;
+}
+
+// The rest of the payload as a terminated string
+static int take_text(const uint8_t *payload, uint32_t remaining, char *text, size_t size) {
+    if (remaining == 0 || remaining >= size || memchr(payload, '\0', remaining)) {
+        return 0;
+    }
+    memcpy(text, payload, remaining);
+    text[remaining] = '\0';
+    return 1;
+}
+
+static daemon_config_slot_t* take_handle(config_daemon_t *daemon, const uint8_t **payload, uint32_t *remaining,
+                                         daemon_response_t *response) {
+    uint32_t handle;
+    if (!take_u32(payload, remaining, &handle)) {
+        fail_response(response, BIOS_ERROR_FORMAT, "Error: Missing config handle");
+        return NULL;
+    }
+    if (handle >= (uint32_t)daemon->config_count) {
+        fail_response(response, BIOS_ERROR_INVALID_SETTING, "Error: Unknown config handle %u", handle);
+        return NULL;
+    }
+    return &daemon->configs[handle];
+}
+
+// Operations
+
+static void handle_open(config_daemon_t *daemon, const uint8_t *payload, uint32_t length,
+                        daemon_response_t *response) {
+    char path[DAEMON_CONFIG_PATH_MAX];
+    if (!take_text(payload, length, path, sizeof(path))) {
+        fail_response(response, BIOS_ERROR_FORMAT, "Error: Invalid config path");
+        return;
+    }
+
+    int handle = -1;
+    for (int i = 0; i < daemon->config_count; i++) {
+        if (strcmp(daemon->configs[i].path, path) == 0) {
+            handle = i;
+            break;
+        }
+    }
+    if (handle < 0) {
+        if (daemon->config_count == daemon->config_capacity) {
+            int capacity = daemon->config_capacity ? daemon->config_capacity * 2 : 16;
+            daemon_config_slot_t *grown = realloc(daemon->configs, sizeof(daemon_config_slot_t) * capacity);
+            if (!grown) {
+                fail_response(response, BIOS_ERROR_FILE, "Error: Cannot allocate config slot");
+                return;
+            }
+            daemon->configs = grown;
+            daemon->config_capacity = capacity;
+        }
+        handle = daemon->config_count;
+        memset(&daemon->configs[handle], 0, sizeof(daemon_config_slot_t));
+        strcpy(daemon->configs[handle].path, path);
+    }
+
+    // Unmodified configs follow the file; the cache makes this a stat when it has not changed
+    daemon_config_slot_t *slot = &daemon->configs[handle];
+    if (!slot->modified) {
+        bios_report_t report;
+        init_report(&report);
+        int result = load_cached_config(path, &slot->config, &report);
+        if (result != BIOS_SUCCESS) {
+            fail_response(response, result, "%s", report.message_count ? report.messages[0] : "Error: Cannot load config");
+            return;
+        }
+    }
+    if (handle == daemon->config_count) {
+        daemon->config_count++;
+    }
+
+    put_u32(response, (uint32_t)handle);
+    put_u16(response, (uint16_t)slot->config.setting_count);
+}
+
+static void handle_get(config_daemon_t *daemon, const uint8_t *payload, uint32_t length,
+                       daemon_response_t *response) {
+    daemon_config_slot_t *slot = take_handle(daemon, &payload, &length, response);
+    char name[MAX_SETTING_NAME];
+    if (!slot) {
+        return;
+    }
+    if (!take_text(payload, length, name, sizeof(name))) {
+        fail_response(response, BIOS_ERROR_FORMAT, "Error: Invalid setting name");
+        return;
+    }
+
+    const bios_setting_t *setting = find_setting(&slot->config, name);
+    if (!setting) {
+        fail_response(response, BIOS_ERROR_INVALID_SETTING, "Error: Unknown setting %s", name);
+        return;
+    }
+    put_u32(response, get_setting_value(setting));
+}
+
+static void handle_set(config_daemon_t *daemon, const uint8_t *payload, uint32_t length,
+                       daemon_response_t *response) {
+    daemon_config_slot_t *slot = take_handle(daemon, &payload, &length, response);
+    uint32_t value;
+    char name[MAX_SETTING_NAME];
+    if (!slot) {
+        return;
+    }
+    if (!take_u32(&payload, &length, &value) || !take_text(payload, length, name, sizeof(name))) {
+        fail_response(response, BIOS_ERROR_FORMAT, "Error: Invalid set request");
+        return;
+    }
+
+    const bios_setting_t *setting = find_setting(&slot->config, name);
+    if (!setting) {
+        fail_response(response, BIOS_ERROR_INVALID_SETTING, "Error: Unknown setting %s", name);
+        return;
+    }
+    uint8_t data[MAX_SETTING_DATA];
+    if (encode_setting_value(setting, value, data) != BIOS_SUCCESS ||
+        validate_setting_value(setting, data) != BIOS_SUCCESS) {
+        fail_response(response, BIOS_ERROR_INVALID_SETTING, "Error: Value %u out of range for %s", value, name);
+        return;
+    }
+    set_setting_by_name(&slot->config, name, data);
+    slot->modified = 1;
+}
+
+static void handle_validate(config_daemon_t *daemon, const uint8_t *payload, uint32_t length,
+                            daemon_response_t *response) {
+    daemon_config_slot_t *slot = take_handle(daemon, &payload, &length, response);
+    if (!slot) {
+        return;
+    }
+
+    bios_report_t report;
+    init_report(&report);
+    response->status = (int16_t)validate_all_settings(&slot->config, &report);
+    put_u16(response, (uint16_t)report.error_count);
+    put_u16(response, (uint16_t)report.warning_count);
+    for (int i = 0; i < report.message_count; i++) {
+        size_t message_length = strlen(report.messages[i]);
+        memcpy(response->payload + response->length, report.messages[i], message_length);
+        response->length += message_length;
+        response->payload[response->length++] = '\n';
+    }
+}
+
+static void put_diff(daemon_response_t *response, const char *name, uint8_t presence, uint32_t first, uint32_t second) {
+    uint8_t name_length = (uint8_t)strnlen(name, MAX_SETTING_NAME);
+    response->payload[response->length++] = name_length;
+    memcpy(response->payload + response->length, name, name_length);
+    response->length += name_length;
+    response->payload[response->length++] = presence;
+    put_u32(response, first);
+    put_u32(response, second);
+}
+
+static void handle_diff(config_daemon_t *daemon, const uint8_t *payload, uint32_t length,
+                        daemon_response_t *response) {
+    daemon_config_slot_t *slot = take_handle(daemon, &payload, &length, response);
+    if (!slot) {
+        return;
+    }
+    const bios_config_t *first = &slot->config;
+    slot = take_handle(daemon, &payload, &length, response);
+    if (!slot) {
+        return;
+    }
+    const bios_config_t *second = &slot->config;
+
+    uint16_t count = 0;
+    response->length = sizeof(count);
+    for (int i = 0; i < first->setting_count; i++) {
+        const bios_setting_t *setting = &first->settings[i];
+        const bios_setting_t *other = find_setting(second, setting->name);
+        if (!other) {
+            put_diff(response, setting->name, 1, get_setting_value(setting), 0);
+            count++;
+        } else if (get_setting_value(setting) != get_setting_value(other)) {
+            put_diff(response, setting->name, 3, get_setting_value(setting), get_setting_value(other));
+            count++;
+        }
+    }
+    for (int i = 0; i < second->setting_count; i++) {
+        const bios_setting_t *setting = &second->settings[i];
+        if (!find_setting(first, setting->name)) {
+            put_diff(response, setting->name, 2, 0, get_setting_value(setting));
+            count++;
+        }
+    }
+    memcpy(response->payload, &count, sizeof(count));
+}
+
+static void handle_save(config_daemon_t *daemon, const uint8_t *payload, uint32_t length,
+                        daemon_response_t *response) {
+    daemon_config_slot_t *slot = take_handle(daemon, &payload, &length, response);
+    char path[DAEMON_CONFIG_PATH_MAX];
+    if (!slot) {
+        return;
+    }
+    if (length == 0) {
+        strcpy(path, slot->path);
+    } else if (!take_text(payload, length, path, sizeof(path))) {
+        fail_response(response, BIOS_ERROR_FORMAT, "Error: Invalid save path");
+        return;
+    }
+
+    bios_report_t report;
+    init_report(&report);
+    int result = save_bios_config_report(path, &slot->config, &report);
+    if (result != BIOS_SUCCESS) {
+        fail_response(response, result, "%s", report.message_count ? report.messages[0] : "Error: Save failed");
+        return;
+    }
+    if (strcmp(path, slot->path) == 0) {
+        slot->modified = 0;
+    }
+}
+
+static void handle_request(config_daemon_t *daemon, const daemon_frame_t *request, const uint8_t *payload,
+                           daemon_response_t *response) {
+    response->status = BIOS_SUCCESS;
+    response->length = 0;
+    daemon->request_count++;
+
+    switch (request->opcode) {
+        case DAEMON_OP_OPEN:
+            handle_open(daemon, payload, request->length, response);
+            break;
+        case DAEMON_OP_GET:
+            handle_get(daemon, payload, request->length, response);
+            break;
+        case DAEMON_OP_SET:
+            handle_set(daemon, payload, request->length, response);
+            break;
+        case DAEMON_OP_VALIDATE:
+            handle_validate(daemon, payload, request->length, response);
+            break;
+        case DAEMON_OP_DIFF:
+            handle_diff(daemon, payload, request->length, response);
+            break;
+        case DAEMON_OP_SAVE:
+            handle_save(daemon, payload, request->length, response);
+            break;
+        default:
+            fail_response(response, BIOS_ERROR_FORMAT, "Error: Unknown opcode %u", request->opcode);
+            break;
+    }
+}
+
+// Connections
+
+static int queue_response(daemon_connection_t *connection, uint8_t opcode, const daemon_response_t *response) {
+    size_t needed = connection->output_used + sizeof(daemon_frame_t) + response->length;
+    if (needed > connection->output_capacity) {
+        size_t capacity = connection->output_capacity ? connection->output_capacity : DAEMON_FRAME_MAX;
+        while (capacity < needed) {
+            capacity *= 2;
+        }
+        uint8_t *grown = realloc(connection->output, capacity);
+        if (!grown) {
+            return BIOS_ERROR_FILE;
+        }
+        connection->output = grown;
+        connection->output_capacity = capacity;
+    }
+
+    daemon_frame_t frame;
+    frame.length = response->length;
+    frame.opcode = opcode;
+    frame.reserved = 0;
+    frame.status = response->status;
+    memcpy(connection->output + connection->output_used, &frame, sizeof(frame));
+    memcpy(connection->output + connection->output_used + sizeof(frame), response->payload, response->length);
+    connection->output_used = needed;
+    return BIOS_SUCCESS;
+}
+
+static void close_connection(config_daemon_t *daemon, daemon_connection_t *connection) {
+    epoll_ctl(daemon->epoll_fd, EPOLL_CTL_DEL, connection->fd, NULL);
+    close(connection->fd);
+    if (connection->prev) {
+        connection->prev->next = connection->next;
+    } else {
+        daemon->connections = connection->next;
+    }
+    if (connection->next) {
+        connection->next->prev = connection->prev;
+    }
+    free(connection->output);
+    free(connection);
+}
+
+// Send what the socket takes; returns -1 when the client is gone
+static int flush_connection(daemon_connection_t *connection) {
+    while (connection->output_sent < connection->output_used) {
+        ssize_t sent = send(connection->fd, connection->output + connection->output_sent,
+                            connection->output_used - connection->output_sent, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno == EAGAIN || errno == EWOULDBLOCK ? 0 : -1;
+        }
+        connection->output_sent += (size_t)sent;
+    }
+    connection->output_used = connection->output_sent = 0;
+    return 0;
+}
+
+// Answer every complete frame in the input buffer; returns -1 on a malformed frame
+static int process_input(config_daemon_t *daemon, daemon_connection_t *connection) {
+    static daemon_response_t response;
+    size_t offset = 0;
+
+    while (connection->input_used - offset >= sizeof(daemon_frame_t)) {
+        daemon_frame_t request;
+        memcpy(&request, connection->input + offset, sizeof(request));
+        if (request.length > DAEMON_MAX_PAYLOAD) {
+            return -1;
+        }
+        if (connection->input_used - offset < sizeof(request) + request.length) {
+            break;
+        }
+        handle_request(daemon, &request, connection->input + offset + sizeof(request), &response);
+        if (queue_response(connection, request.opcode, &response) != BIOS_SUCCESS) {
+            return -1;
+        }
+        offset += sizeof(request) + request.length;
+    }
+
+    memmove(connection->input, connection->input + offset, connection->input_used - offset);
+    connection->input_used -= offset;
+    return 0;
+}
+
+// Watch for writability while responses are pending; stop reading while too many are
+static void update_interest(config_daemon_t *daemon, daemon_connection_t *connection) {
+    size_t pending = connection->output_used - connection->output_sent;
+    struct epoll_event event;
+    event.events = (pending ? EPOLLOUT : 0) | (pending < DAEMON_OUTPUT_HIGH_WATER ? EPOLLIN : 0);
+    event.data.ptr = connection;
+    if (event.events != connection->events) {
+        epoll_ctl(daemon->epoll_fd, EPOLL_CTL_MOD, connection->fd, &event);
+        connection->events = event.events;
+    }
+}
+
+static void handle_connection(config_daemon_t *daemon, daemon_connection_t *connection, uint32_t events) {
+    if (events & (EPOLLERR | EPOLLHUP)) {
+        close_connection(daemon, connection);
+        return;
+    }
+
+    if (events & EPOLLIN) {
+        for (;;) {
+            ssize_t received = recv(connection->fd, connection->input + connection->input_used,
+                                    sizeof(connection->input) - connection->input_used, 0);
+            if (received == 0) {
+                close_connection(daemon, connection);
+                return;
+            }
+            if (received < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    break;
+                }
+                close_connection(daemon, connection);
+                return;
+            }
+            connection->input_used += (size_t)received;
+            if (process_input(daemon, connection) != 0) {
+                close_connection(daemon, connection);
+                return;
+            }
+        }
+    }
+
+    if (flush_connection(connection) != 0) {
+        close_connection(daemon, connection);
+        return;
+    }
+    update_interest(daemon, connection);
+}
+
+static void accept_connections(config_daemon_t *daemon) {
+    for (;;) {
+        int fd = accept4(daemon->listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;     // EAGAIN, or out of descriptors until a client leaves
+        }
+
+        daemon_connection_t *connection = calloc(1, sizeof(daemon_connection_t));
+        if (!connection) {
+            close(fd);
+            continue;
+        }
+        connection->fd = fd;
+        connection->events = EPOLLIN;
+
+        struct epoll_event event;
+        event.events = EPOLLIN;
+        event.data.ptr = connection;
+        if (epoll_ctl(daemon->epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            close(fd);
+            free(connection);
+            continue;
+        }
+        connection->next = daemon->connections;
+        if (daemon->connections) {
+            daemon->connections->prev = connection;
+        }
+        daemon->connections = connection;
+    }
+}
+
+int open_config_daemon(config_daemon_t *daemon, const char *socket_path) {
+    memset(daemon, 0, sizeof(config_daemon_t));
+    daemon->listen_fd = daemon->epoll_fd = -1;
+
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(socket_path) >= sizeof(address.sun_path)) {
+        printf("Error: Socket path too long: %s\n", socket_path);
+        return BIOS_ERROR_FILE;
+    }
+    strcpy(address.sun_path, socket_path);
+
+    daemon->listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    daemon->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (daemon->listen_fd < 0 || daemon->epoll_fd < 0) {
+        printf("Error: Cannot create daemon socket\n");
+        close_config_daemon(daemon);
+        return BIOS_ERROR_FILE;
+    }
+
+    // Only a stale socket is replaced; anything else at the path is left alone
+    struct stat existing;
+    if (lstat(socket_path, &existing) == 0) {
+        if (!S_ISSOCK(existing.st_mode)) {
+            printf("Error: %s exists and is not a socket\n", socket_path);
+            close_config_daemon(daemon);
+            return BIOS_ERROR_FILE;
+        }
+        unlink(socket_path);
+    }
+
+    // Clients can load and save files as the daemon's user: owner-only socket.
+    // The umask is process-wide; the daemon opens before it starts any threads.
+    mode_t previous_umask = umask(077);
+    int bound = bind(daemon->listen_fd, (struct sockaddr*)&address, sizeof(address)) == 0;
+    umask(previous_umask);
+    if (!bound) {
+        printf("Error: Cannot listen on %s\n", socket_path);
+        close_config_daemon(daemon);
+        return BIOS_ERROR_FILE;
+    }
+    strcpy(daemon->socket_path, socket_path);      // Ours to unlink from here on
+    if (listen(daemon->listen_fd, SOMAXCONN) != 0) {
+        printf("Error: Cannot listen on %s\n", socket_path);
+        close_config_daemon(daemon);
+        return BIOS_ERROR_FILE;
+    }
+
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = NULL;      // NULL marks the listening socket
+    if (epoll_ctl(daemon->epoll_fd, EPOLL_CTL_ADD, daemon->listen_fd, &event) != 0) {
+        printf("Error: Cannot watch %s\n", socket_path);
+        close_config_daemon(daemon);
+        return BIOS_ERROR_FILE;
+    }
+    return BIOS_SUCCESS;
+}
+
+int run_config_daemon(config_daemon_t *daemon) {
+    struct epoll_event events[DAEMON_MAX_EVENTS];
+
+    while (!daemon->stop_requested) {
+        // The timeout bounds how long a stop request waits
+        int ready = epoll_wait(daemon->epoll_fd, events, DAEMON_MAX_EVENTS, 200);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            printf("Error: Daemon event loop failed\n");
+            return BIOS_ERROR_FILE;
+        }
+        for (int i = 0; i < ready; i++) {
+            if (events[i].data.ptr) {
+                handle_connection(daemon, events[i].data.ptr, events[i].events);
+            } else {
+                accept_connections(daemon);
+            }
+        }
+    }
+    return BIOS_SUCCESS;
+}
+
+void close_config_daemon(config_daemon_t *daemon) {
+    while (daemon->connections) {
+        close_connection(daemon, daemon->connections);
+    }
+    if (daemon->listen_fd >= 0) {
+        close(daemon->listen_fd);
+    }
+    if (daemon->socket_path[0]) {
+        unlink(daemon->socket_path);
+        daemon->socket_path[0] = '\0';
+    }
+    if (daemon->epoll_fd >= 0) {
+        close(daemon->epoll_fd);
+    }
+    free(daemon->configs);
+    daemon->configs = NULL;
+    daemon->config_count = daemon->config_capacity = 0;
+    daemon->listen_fd = daemon->epoll_fd = -1;
+}
+
+#else
+
+int open_config_daemon(config_daemon_t *daemon, const char *socket_path) {
+    (void)socket_path;
+    memset(daemon, 0, sizeof(config_daemon_t));
+    printf("Error: The config daemon needs Unix sockets and epoll (Linux)\n");
+    return BIOS_ERROR_FILE;
+}
+
+int run_config_daemon(config_daemon_t *daemon) {
+    (void)daemon;
+    return BIOS_ERROR_FILE;
+}
+
+void close_config_daemon(config_daemon_t *daemon) {
+    (void)daemon;
+}
+
+#endif
+
+void stop_config_daemon(config_daemon_t *daemon) {
+    daemon->stop_requested = 1;
+}
\ No newline at end of file
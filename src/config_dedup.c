@@ -0,0 +1,513 @@
+#include "../include/config_dedup.h"
+#include "../include/config_parser.h"
+#include "../include/validator.h"
+#include "../include/checksum.h"
+#include "../include/atomic_save.h"
+
+#define DEDUP_INITIAL_BUCKETS 256
+
+// On-disk layout: header, distinct payloads, then machines referring to them by position
+typedef struct __attribute__((packed)) {
+    char signature[4];          // "SYSS"
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t blob_count;
+    uint32_t machine_count;
+} dedup_file_header_t;
+
+typedef struct __attribute__((packed)) {
+    uint32_t setting_count;
+    uint32_t crc32c;            // Over the settings that follow
+} dedup_file_blob_t;
+
+typedef struct __attribute__((packed)) {
+    char machine[DEDUP_MACHINE_MAX];
+    uint32_t blob;
+    uint32_t integrity;
+    bios_config_header_t header;
+} dedup_file_machine_t;
+
+// 64-bit payload hash, so distinct payloads rarely share a chain. Consumes 8 bytes per step
+// (a byte-wise hash cost more than the validation it saves) and mixes at the end, since
+// buckets take the low bits. Only kept in memory: stores on disk carry a CRC32C instead.
+static uint64_t hash_payload(const void *data, size_t size) {
+    const uint8_t *bytes = data;
+    uint64_t hash = 14695981039346656037ull ^ size;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, bytes + i, sizeof(word));
+        hash ^= word * 0x9E3779B97F4A7C15ull;
+        hash = ((hash << 27) | (hash >> 37)) * 0xC2B2AE3D27D4EB4Full;
+    }
+    for (; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+static uint32_t hash_machine(const char *machine) {
+    uint32_t hash = 2166136261u;
+    for (const unsigned char *p = (const unsigned char*)machine; *p; p++) {
+        hash = (hash ^ *p) * 16777619u;
+    }
+    return hash;
+}
+
+void init_dedup_store(dedup_store_t *store) {
+    memset(store, 0, sizeof(dedup_store_t));
+}
+
+void free_dedup_store(dedup_store_t *store) {
+    for (size_t i = 0; i < store->blob_count; i++) {
+        free(store->blobs[i].settings);
+        free(store->blobs[i].validation_report);
+    }
+    free(store->blobs);
+    free(store->blob_buckets);
+    free(store->refs);
+    free(store->ref_buckets);
+    init_dedup_store(store);
+}
+
+// Relink both hash tables over bucket_count buckets
+static int rehash_dedup_store(dedup_store_t *store, size_t bucket_count) {
+    uint32_t *blob_buckets = calloc(bucket_count, sizeof(uint32_t));
+    uint32_t *ref_buckets = calloc(bucket_count, sizeof(uint32_t));
+    if (!blob_buckets || !ref_buckets) {
+        free(blob_buckets);
+        free(ref_buckets);
+        return BIOS_ERROR_FILE;
+    }
+
+    for (size_t i = 0; i < store->blob_count; i++) {
+        dedup_blob_t *blob = &store->blobs[i];
+        if (blob->ref_count) {
+            uint32_t bucket = (uint32_t)(blob->hash & (bucket_count - 1));
+            blob->next = blob_buckets[bucket];
+            blob_buckets[bucket] = (uint32_t)i + 1;
+        }
+    }
+    for (size_t i = 0; i < store->ref_count; i++) {
+        uint32_t bucket = hash_machine(store->refs[i].machine) & (uint32_t)(bucket_count - 1);
+        store->refs[i].next = ref_buckets[bucket];
+        ref_buckets[bucket] = (uint32_t)i + 1;
+    }
+
+    free(store->blob_buckets);
+    free(store->ref_buckets);
+    store->blob_buckets = blob_buckets;
+    store->ref_buckets = ref_buckets;
+    store->bucket_count = bucket_count;
+    return BIOS_SUCCESS;
+}
+
+// Room for one more blob and one more machine
+static int reserve_dedup_store(dedup_store_t *store) {
+    if (store->blob_count == store->blob_capacity) {
+        size_t capacity = store->blob_capacity ? store->blob_capacity * 2 : 64;
+        dedup_blob_t *blobs = realloc(store->blobs, sizeof(dedup_blob_t) * capacity);
+        if (!blobs) {
+            return BIOS_ERROR_FILE;
+        }
+        store->blobs = blobs;
+        store->blob_capacity = capacity;
+    }
+    if (store->ref_count == store->ref_capacity) {
+        size_t capacity = store->ref_capacity ? store->ref_capacity * 2 : 64;
+        dedup_ref_t *refs = realloc(store->refs, sizeof(dedup_ref_t) * capacity);
+        if (!refs) {
+            return BIOS_ERROR_FILE;
+        }
+        store->refs = refs;
+        store->ref_capacity = capacity;
+    }
+
+    size_t needed = store->blob_count > store->ref_count ? store->blob_count : store->ref_count;
+    if (needed + 1 > store->bucket_count) {
+        size_t bucket_count = store->bucket_count ? store->bucket_count * 2 : DEDUP_INITIAL_BUCKETS;
+        return rehash_dedup_store(store, bucket_count);
+    }
+    return BIOS_SUCCESS;
+}
+
+static int find_ref(const dedup_store_t *store, const char *machine) {
+    if (!store->bucket_count) {
+        return -1;
+    }
+    uint32_t link = store->ref_buckets[hash_machine(machine) & (store->bucket_count - 1)];
+    while (link) {
+        const dedup_ref_t *ref = &store->refs[link - 1];
+        if (strcmp(ref->machine, machine) == 0) {
+            return (int)(link - 1);
+        }
+        link = ref->next;
+    }
+    return -1;
+}
+
+// Take a reference to the stored copy of settings, adding it if it is new
+static int acquire_blob(dedup_store_t *store, const bios_setting_t *settings, int count, uint32_t *index) {
+    size_t size = sizeof(bios_setting_t) * count;
+    uint64_t hash = hash_payload(settings, size);
+    uint32_t bucket = (uint32_t)(hash & (store->bucket_count - 1));
+
+    for (uint32_t link = store->blob_buckets[bucket]; link; link = store->blobs[link - 1].next) {
+        dedup_blob_t *blob = &store->blobs[link - 1];
+        if (blob->hash == hash && blob->setting_count == count && memcmp(blob->settings, settings, size) == 0) {
+            blob->ref_count++;
+            *index = link - 1;
+            return BIOS_SUCCESS;
+        }
+    }
+
+    bios_setting_t *copy = malloc(size ? size : 1);
+    if (!copy) {
+        return BIOS_ERROR_FILE;
+    }
+    memcpy(copy, settings, size);
+
+    uint32_t slot;
+    if (store->free_blobs) {
+        slot = store->free_blobs - 1;
+        store->free_blobs = store->blobs[slot].next;
+    } else {
+        slot = (uint32_t)store->blob_count++;
+    }
+    dedup_blob_t *blob = &store->blobs[slot];
+    blob->hash = hash;
+    blob->ref_count = 1;
+    blob->setting_count = count;
+    blob->settings = copy;
+    blob->validation_result = DEDUP_NOT_VALIDATED;
+    blob->validation_report = NULL;
+    blob->next = store->blob_buckets[bucket];
+    store->blob_buckets[bucket] = slot + 1;
+
+    store->stats.unique_count++;
+    store->stats.stored_bytes += size;
+    *index = slot;
+    return BIOS_SUCCESS;
+}
+
+static void release_blob(dedup_store_t *store, uint32_t index) {
+    dedup_blob_t *blob = &store->blobs[index];
+    if (--blob->ref_count) {
+        return;
+    }
+
+    uint32_t *link = &store->blob_buckets[blob->hash & (store->bucket_count - 1)];
+    while (*link != index + 1) {
+        link = &store->blobs[*link - 1].next;
+    }
+    *link = blob->next;
+
+    store->stats.unique_count--;
+    store->stats.stored_bytes -= sizeof(bios_setting_t) * blob->setting_count;
+    free(blob->settings);
+    free(blob->validation_report);
+    blob->settings = NULL;
+    blob->validation_report = NULL;
+    blob->next = store->free_blobs;
+    store->free_blobs = index + 1;
+}
+
+static int put_settings(dedup_store_t *store, const char *machine, const bios_config_header_t *header,
+                        int integrity, const bios_setting_t *settings, int count) {
+    if (strlen(machine) >= DEDUP_MACHINE_MAX) {
+        printf("Error: Machine name too long: %s\n", machine);
+        return BIOS_ERROR_INVALID_SETTING;
+    }
+    if (reserve_dedup_store(store) != BIOS_SUCCESS) {
+        printf("Error: Cannot grow snapshot store\n");
+        return BIOS_ERROR_FILE;
+    }
+
+    uint32_t blob;
+    if (acquire_blob(store, settings, count, &blob) != BIOS_SUCCESS) {
+        printf("Error: Cannot store settings for %s\n", machine);
+        return BIOS_ERROR_FILE;
+    }
+
+    int existing = find_ref(store, machine);
+    dedup_ref_t *ref;
+    if (existing >= 0) {
+        // Taken before the old one is released, so an unchanged payload is never freed
+        ref = &store->refs[existing];
+        store->stats.logical_bytes -= sizeof(bios_setting_t) * store->blobs[ref->blob].setting_count;
+        release_blob(store, ref->blob);
+    } else {
+        uint32_t index = (uint32_t)store->ref_count++;
+        uint32_t bucket = hash_machine(machine) & (uint32_t)(store->bucket_count - 1);
+        ref = &store->refs[index];
+        strcpy(ref->machine, machine);
+        ref->next = store->ref_buckets[bucket];
+        store->ref_buckets[bucket] = index + 1;
+        store->stats.machine_count++;
+    }
+    ref->header = *header;
+    ref->integrity = integrity;
+    ref->blob = blob;
+    store->stats.logical_bytes += sizeof(bios_setting_t) * count;
+    return BIOS_SUCCESS;
+}
+
+int dedup_store_put(dedup_store_t *store, const char *machine, const bios_config_t *config) {
+    return put_settings(store, machine, &config->header, config->integrity, config->settings, config->setting_count);
+}
+
+int dedup_store_get(const dedup_store_t *store, const char *machine, bios_config_t *config) {
+    int index = find_ref(store, machine);
+    if (index < 0) {
+        return BIOS_ERROR_INVALID_SETTING;
+    }
+    const dedup_ref_t *ref = &store->refs[index];
+    const dedup_blob_t *blob = &store->blobs[ref->blob];
+
+    memset(config, 0, sizeof(bios_config_t));
+    config->header = ref->header;
+    config->integrity = ref->integrity;
+    config->setting_count = blob->setting_count;
+    memcpy(config->settings, blob->settings, sizeof(bios_setting_t) * blob->setting_count);
+    config->checksum_stale = calculate_checksum(config) != config->header.checksum;
+    rebuild_setting_index(config);
+    return BIOS_SUCCESS;
+}
+
+// Swap the last machine into the removed slot, relinking it under its new index
+int dedup_store_remove(dedup_store_t *store, const char *machine) {
+    int index = find_ref(store, machine);
+    if (index < 0) {
+        return BIOS_ERROR_INVALID_SETTING;
+    }
+
+    uint32_t mask = (uint32_t)(store->bucket_count - 1);
+    uint32_t *link = &store->ref_buckets[hash_machine(machine) & mask];
+    while (*link != (uint32_t)index + 1) {
+        link = &store->refs[*link - 1].next;
+    }
+    *link = store->refs[index].next;
+
+    dedup_ref_t *ref = &store->refs[index];
+    store->stats.logical_bytes -= sizeof(bios_setting_t) * store->blobs[ref->blob].setting_count;
+    store->stats.machine_count--;
+    release_blob(store, ref->blob);
+
+    uint32_t last = (uint32_t)--store->ref_count;
+    if ((uint32_t)index != last) {
+        link = &store->ref_buckets[hash_machine(store->refs[last].machine) & mask];
+        while (*link != last + 1) {
+            link = &store->refs[*link - 1].next;
+        }
+        *link = (uint32_t)index + 1;
+        store->refs[index] = store->refs[last];
+    }
+    return BIOS_SUCCESS;
+}
+
+// Add src's messages and counts to dst, or print them when dst is NULL
+static void merge_report(bios_report_t *dst, const bios_report_t *src) {
+    if (!dst) {
+        for (int i = 0; i < src->message_count; i++) {
+            printf("%s\n", src->messages[i]);
+        }
+        return;
+    }
+    for (int i = 0; i < src->message_count && dst->message_count < REPORT_MAX_MESSAGES; i++) {
+        memcpy(dst->messages[dst->message_count++], src->messages[i], REPORT_MESSAGE_LEN);
+    }
+    dst->error_count += src->error_count;
+    dst->warning_count += src->warning_count;
+}
+
+int dedup_store_validate(dedup_store_t *store, const char *machine, bios_report_t *report) {
+    int index = find_ref(store, machine);
+    if (index < 0) {
+        report_message(report, REPORT_ERROR, "Error: Unknown machine %s", machine);
+        return BIOS_ERROR_INVALID_SETTING;
+    }
+
+    dedup_blob_t *blob = &store->blobs[store->refs[index].blob];
+    if (!blob->validation_report) {
+        blob->validation_report = malloc(sizeof(bios_report_t));
+        if (!blob->validation_report) {
+            report_message(report, REPORT_ERROR, "Error: Cannot allocate validation report");
+            return BIOS_ERROR_FILE;
+        }
+        init_report(blob->validation_report);
+        blob->validation_result = validate_settings_table(blob->settings, blob->setting_count,
+                                                          blob->validation_report);
+        store->stats.validations_run++;
+    } else {
+        store->stats.validations_cached++;
+    }
+
+    merge_report(report, blob->validation_report);
+    return blob->validation_result;
+}
+
+void get_dedup_stats(const dedup_store_t *store, dedup_stats_t *stats) {
+    *stats = store->stats;
+}
+
+int save_dedup_store(const dedup_store_t *store, const char *filename) {
+    // Distinct payloads are numbered in slot order, skipping free slots
+    uint32_t *ordinals = malloc(sizeof(uint32_t) * (store->blob_count ? store->blob_count : 1));
+    if (!ordinals) {
+        printf("Error: Cannot allocate snapshot store image\n");
+        return BIOS_ERROR_FILE;
+    }
+    size_t size = sizeof(dedup_file_header_t) + sizeof(dedup_file_machine_t) * store->ref_count;
+    uint32_t unique = 0;
+    for (size_t i = 0; i < store->blob_count; i++) {
+        if (store->blobs[i].ref_count) {
+            ordinals[i] = unique++;
+            size += sizeof(dedup_file_blob_t) + sizeof(bios_setting_t) * store->blobs[i].setting_count;
+        }
+    }
+
+    uint8_t *image = malloc(size);
+    if (!image) {
+        free(ordinals);
+        printf("Error: Cannot allocate snapshot store image\n");
+        return BIOS_ERROR_FILE;
+    }
+
+    dedup_file_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.signature, DEDUP_SIGNATURE, 4);
+    header.version = DEDUP_VERSION;
+    header.blob_count = unique;
+    header.machine_count = (uint32_t)store->ref_count;
+    memcpy(image, &header, sizeof(header));
+
+    size_t offset = sizeof(header);
+    for (size_t i = 0; i < store->blob_count; i++) {
+        const dedup_blob_t *blob = &store->blobs[i];
+        if (!blob->ref_count) {
+            continue;
+        }
+        size_t settings_size = sizeof(bios_setting_t) * blob->setting_count;
+        dedup_file_blob_t record;
+        record.setting_count = (uint32_t)blob->setting_count;
+        record.crc32c = checksum_crc32c(0, blob->settings, settings_size);
+        memcpy(image + offset, &record, sizeof(record));
+        memcpy(image + offset + sizeof(record), blob->settings, settings_size);
+        offset += sizeof(record) + settings_size;
+    }
+    for (size_t i = 0; i < store->ref_count; i++) {
+        const dedup_ref_t *ref = &store->refs[i];
+        dedup_file_machine_t record;
+        memset(&record, 0, sizeof(record));
+        strcpy(record.machine, ref->machine);
+        record.blob = ordinals[ref->blob];
+        record.integrity = (uint32_t)ref->integrity;
+        record.header = ref->header;
+        memcpy(image + offset, &record, sizeof(record));
+        offset += sizeof(record);
+    }
+
+    int result = write_file_atomic(filename, image, size, NULL, NULL);
+    if (result == BIOS_SUCCESS) {
+        printf("Snapshot store saved to %s: %lu machines, %lu distinct configurations\n",
+               filename, (unsigned long)store->ref_count, (unsigned long)unique);
+    }
+    free(image);
+    free(ordinals);
+    return result;
+}
+
+int load_dedup_store(const char *filename, dedup_store_t *store) {
+    init_dedup_store(store);
+
+    FILE *file = fopen(filename, "rb");
+    if (!file) {
+        printf("Error: Cannot open file %s\n", filename);
+        return BIOS_ERROR_FILE;
+    }
+    fseek(file, 0, SEEK_END);
+    long file_size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    uint8_t *image = file_size > 0 ? malloc((size_t)file_size) : NULL;
+    if (!image || fread(image, 1, (size_t)file_size, file) != (size_t)file_size) {
+        fclose(file);
+        free(image);
+        printf("Error: Cannot read snapshot store %s\n", filename);
+        return BIOS_ERROR_FILE;
+    }
+    fclose(file);
+
+    size_t size = (size_t)file_size;
+    dedup_file_header_t header;
+    if (size < sizeof(header)) {
+        free(image);
+        printf("Error: Invalid snapshot store %s\n", filename);
+        return BIOS_ERROR_FORMAT;
+    }
+    memcpy(&header, image, sizeof(header));
+    if (memcmp(header.signature, DEDUP_SIGNATURE, 4) != 0 || header.version != DEDUP_VERSION) {
+        free(image);
+        printf("Error: Invalid snapshot store %s\n", filename);
+        return BIOS_ERROR_FORMAT;
+    }
+
+    // Locate and check every payload before adding anything
+    size_t *payloads = malloc(sizeof(size_t) * (header.blob_count ? header.blob_count : 1));
+    int *counts = malloc(sizeof(int) * (header.blob_count ? header.blob_count : 1));
+    int result = payloads && counts ? BIOS_SUCCESS : BIOS_ERROR_FILE;
+    size_t offset = sizeof(header);
+    for (uint32_t i = 0; i < header.blob_count && result == BIOS_SUCCESS; i++) {
+        dedup_file_blob_t record;
+        if (size - offset < sizeof(record)) {
+            result = BIOS_ERROR_FORMAT;
+            break;
+        }
+        memcpy(&record, image + offset, sizeof(record));
+        offset += sizeof(record);
+        size_t settings_size = sizeof(bios_setting_t) * (size_t)record.setting_count;
+        if (record.setting_count > MAX_SETTINGS || size - offset < settings_size) {
+            result = BIOS_ERROR_FORMAT;
+            break;
+        }
+        if (checksum_crc32c(0, image + offset, settings_size) != record.crc32c) {
+            printf("Error: Configuration %u in %s is corrupt\n", i, filename);
+            result = BIOS_ERROR_CHECKSUM;
+            break;
+        }
+        payloads[i] = offset;
+        counts[i] = (int)record.setting_count;
+        offset += settings_size;
+    }
+    if (result == BIOS_SUCCESS && size - offset != sizeof(dedup_file_machine_t) * (size_t)header.machine_count) {
+        result = BIOS_ERROR_FORMAT;
+    }
+
+    for (uint32_t i = 0; i < header.machine_count && result == BIOS_SUCCESS; i++) {
+        dedup_file_machine_t record;
+        memcpy(&record, image + offset, sizeof(record));
+        offset += sizeof(record);
+        if (record.blob >= header.blob_count || !memchr(record.machine, '\0', DEDUP_MACHINE_MAX)) {
+            result = BIOS_ERROR_FORMAT;
+            break;
+        }
+        // Settings are copied out of the image, which may not be aligned for them
+        bios_setting_t settings[MAX_SETTINGS];
+        memcpy(settings, image + payloads[record.blob], sizeof(bios_setting_t) * counts[record.blob]);
+        result = put_settings(store, record.machine, &record.header, (int)record.integrity,
+                              settings, counts[record.blob]);
+    }
+
+    if (result == BIOS_ERROR_FORMAT) {
+        printf("Error: Invalid snapshot store %s\n", filename);
+    }
+    if (result != BIOS_SUCCESS) {
+        free_dedup_store(store);
+    }
+    free(payloads);
+    free(counts);
+    free(image);
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,204 @@
+#include "../include/config_delta.h"
+#include "../include/config_parser.h"
+#include <stddef.h>
+
+// Everything except the data field must match between base and target
+static int same_setting_layout(const bios_setting_t *a, const bios_setting_t *b) {
+    return memcmp(a, b, offsetof(bios_setting_t, data)) == 0 &&
+           a->min_value == b->min_value && a->max_value == b->max_value;
+}
+
+// Build a delta holding only the changed data bytes
+int create_config_delta(const bios_config_t *base, const bios_config_t *target,
+                        uint8_t *buffer, size_t capacity, size_t *delta_size) {
+    if (base->setting_count != target->setting_count) {
+        printf("Error: Delta requires matching setting lists (%d vs %d settings)\n",
+               base->setting_count, target->setting_count);
+        return BIOS_ERROR_FORMAT;
+    }
+    if (capacity < sizeof(bios_delta_header_t)) {
+        return BIOS_ERROR_FORMAT;
+    }
+
+    bios_delta_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.signature, DELTA_SIGNATURE, 4);
+    header.version = DELTA_VERSION;
+    header.base_setting_count = base->setting_count;
+    header.base_checksum = calculate_checksum(base);
+    header.result_checksum = calculate_checksum(target);
+
+    size_t offset = sizeof(bios_delta_header_t);
+    for (int i = 0; i < base->setting_count; i++) {
+        const bios_setting_t *old_setting = &base->settings[i];
+        const bios_setting_t *new_setting = &target->settings[i];
+
+        if (!same_setting_layout(old_setting, new_setting)) {
+            printf("Error: Setting %s differs in more than its value\n", new_setting->name);
+            return BIOS_ERROR_FORMAT;
+        }
+
+        // Entries always carry the declared size, so bytes past it must not differ
+        int changed = 0;
+        for (int b = 0; b < MAX_SETTING_DATA; b++) {
+            if (old_setting->data[b] != new_setting->data[b]) {
+                changed = b + 1;
+            }
+        }
+        if (changed == 0) {
+            continue;
+        }
+        if (changed > new_setting->size || new_setting->size > MAX_SETTING_DATA) {
+            printf("Error: Setting %s differs beyond its declared size\n", new_setting->name);
+            return BIOS_ERROR_FORMAT;
+        }
+        uint8_t size = new_setting->size;
+
+        if (offset + sizeof(bios_delta_entry_t) + size > capacity) {
+            printf("Error: Delta buffer too small\n");
+            return BIOS_ERROR_FORMAT;
+        }
+        bios_delta_entry_t entry = { (uint16_t)i, size };
+        memcpy(buffer + offset, &entry, sizeof(entry));
+        memcpy(buffer + offset + sizeof(entry), new_setting->data, size);
+        offset += sizeof(entry) + size;
+        header.num_entries++;
+    }
+
+    memcpy(buffer, &header, sizeof(header));
+    *delta_size = offset;
+    return BIOS_SUCCESS;
+}
+
+// Check a delta against a base and compute the checksum it would produce, without modifying anything
+static int walk_config_delta(const bios_config_t *config, const uint8_t *delta, size_t delta_size,
+                             uint16_t *result_checksum) {
+    bios_delta_header_t header;
+    if (delta_size < sizeof(header)) {
+        return BIOS_ERROR_FORMAT;
+    }
+    memcpy(&header, delta, sizeof(header));
+
+    if (memcmp(header.signature, DELTA_SIGNATURE, 4) != 0 || header.version != DELTA_VERSION) {
+        printf("Error: Invalid delta signature\n");
+        return BIOS_ERROR_FORMAT;
+    }
+    if (header.base_setting_count != config->setting_count) {
+        printf("Error: Delta expects %d settings, configuration has %d\n",
+               header.base_setting_count, config->setting_count);
+        return BIOS_ERROR_FORMAT;
+    }
+
+    uint16_t checksum = calculate_checksum(config);
+    if (checksum != header.base_checksum) {
+        printf("Error: Delta base checksum mismatch (base: %04X, expected: %04X)\n",
+               checksum, header.base_checksum);
+        return BIOS_ERROR_CHECKSUM;
+    }
+
+    size_t offset = sizeof(header);
+    int last_id = -1;
+    for (int e = 0; e < header.num_entries; e++) {
+        bios_delta_entry_t entry;
+        if (offset + sizeof(entry) > delta_size) {
+            return BIOS_ERROR_FORMAT;
+        }
+        memcpy(&entry, delta + offset, sizeof(entry));
+        offset += sizeof(entry);
+
+        // Ids must be strictly increasing so each setting changes once, with exactly its size
+        if ((int)entry.setting_id <= last_id || entry.setting_id >= config->setting_count ||
+            entry.size != config->settings[entry.setting_id].size || entry.size > MAX_SETTING_DATA ||
+            offset + entry.size > delta_size) {
+            printf("Error: Corrupt delta entry %d\n", e);
+            return BIOS_ERROR_FORMAT;
+        }
+        last_id = entry.setting_id;
+
+        checksum = update_checksum_bytes(checksum, config->settings[entry.setting_id].data, delta + offset, entry.size);
+        offset += entry.size;
+    }
+    // A truncated or concatenated delta must not verify
+    if (offset != delta_size) {
+        printf("Error: Delta has %lu bytes after its last entry\n", (unsigned long)(delta_size - offset));
+        return BIOS_ERROR_FORMAT;
+    }
+
+    if (checksum != header.result_checksum) {
+        printf("Error: Delta result checksum mismatch (result: %04X, expected: %04X)\n",
+               checksum, header.result_checksum);
+        return BIOS_ERROR_CHECKSUM;
+    }
+    *result_checksum = checksum;
+    return BIOS_SUCCESS;
+}
+
+int verify_config_delta(const bios_config_t *base, const uint8_t *delta, size_t delta_size) {
+    uint16_t result_checksum;
+    return walk_config_delta(base, delta, delta_size, &result_checksum);
+}
+
+// Apply a delta in place; the configuration is left untouched if verification fails
+int apply_config_delta(bios_config_t *config, const uint8_t *delta, size_t delta_size) {
+    uint16_t result_checksum;
+    int result = walk_config_delta(config, delta, delta_size, &result_checksum);
+    if (result != BIOS_SUCCESS) {
+        return result;
+    }
+
+    bios_delta_header_t header;
+    memcpy(&header, delta, sizeof(header));
+
+    size_t offset = sizeof(header);
+    for (int e = 0; e < header.num_entries; e++) {
+        bios_delta_entry_t entry;
+        memcpy(&entry, delta + offset, sizeof(entry));
+        offset += sizeof(entry);
+        memcpy(config->settings[entry.setting_id].data, delta + offset, entry.size);
+        offset += entry.size;
+    }
+
+    config->header.checksum = result_checksum;
+    config->checksum_stale = 0;
+    return BIOS_SUCCESS;
+}
+
+int save_config_delta(const char *filename, const uint8_t *delta, size_t delta_size) {
+    FILE *file = fopen(filename, "wb");
+    if (!file) {
+        printf("Error: Cannot create file %s\n", filename);
+        return BIOS_ERROR_FILE;
+    }
+
+    if (fwrite(delta, 1, delta_size, file) != delta_size) {
+        fclose(file);
+        printf("Error: Cannot write delta to %s\n", filename);
+        return BIOS_ERROR_FILE;
+    }
+
+    fclose(file);
+    printf("Delta saved to %s (%lu bytes)\n", filename, (unsigned long)delta_size);
+    return BIOS_SUCCESS;
+}
+
+int load_config_delta(const char *filename, uint8_t *buffer, size_t capacity, size_t *delta_size) {
+    FILE *file = fopen(filename, "rb");
+    if (!file) {
+        printf("Error: Cannot open file %s\n", filename);
+        return BIOS_ERROR_FILE;
+    }
+
+    *delta_size = fread(buffer, 1, capacity, file);
+    int truncated = !feof(file) && fgetc(file) != EOF;
+    fclose(file);
+
+    if (truncated) {
+        printf("Error: Delta %s is larger than %lu bytes\n", filename, (unsigned long)capacity);
+        return BIOS_ERROR_FORMAT;
+    }
+    if (*delta_size < sizeof(bios_delta_header_t)) {
+        printf("Error: Cannot read delta header from %s\n", filename);
+        return BIOS_ERROR_FORMAT;
+    }
+    return BIOS_SUCCESS;
+}
\ No newline at end of file
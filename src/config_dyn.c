@@ -0,0 +1,218 @@
+#include "../include/config_dyn.h"
+#include "../include/config_parser.h"
+#include "../include/name_index.h"
+#include "../include/config_compact.h"
+#include "../include/stats.h"
+
+// Arena layout: [bios_config_dyn_t][settings x capacity][index slots]
+static size_t index_slots_for(int capacity) {
+    size_t slots = 16;
+    while (slots < (size_t)capacity * 2) {
+        slots <<= 1;
+    }
+    return slots;
+}
+
+static size_t arena_size(int capacity, size_t slots) {
+    return sizeof(bios_config_dyn_t) + sizeof(bios_setting_t) * capacity + sizeof(uint16_t) * slots;
+}
+
+static void layout_arena(bios_config_dyn_t *config, int capacity, size_t slots) {
+    uint8_t *base = (uint8_t*)config + sizeof(bios_config_dyn_t);
+    config->settings = (bios_setting_t*)base;
+    config->index_slots = (uint16_t*)(base + sizeof(bios_setting_t) * capacity);
+    config->setting_capacity = capacity;
+    config->index_slot_count = slots;
+}
+
+static void rebuild_index_dyn(bios_config_dyn_t *config) {
+    build_name_index(config->index_slots, config->index_slot_count, config->settings, config->setting_count);
+}
+
+// Allocate an empty configuration with room for capacity settings
+bios_config_dyn_t* create_config_dyn(int capacity) {
+    if (capacity < 1) {
+        capacity = 1;
+    }
+    if (capacity > MAX_DYN_SETTINGS) {
+        return NULL;
+    }
+
+    size_t slots = index_slots_for(capacity);
+    bios_config_dyn_t *config = malloc(arena_size(capacity, slots));
+    if (!config) {
+        return NULL;
+    }
+
+    memset(config, 0, sizeof(bios_config_dyn_t));
+    layout_arena(config, capacity, slots);
+    memset(config->index_slots, 0, sizeof(uint16_t) * slots);
+    memcpy(config->header.signature, BIOS_SIGNATURE, 4);
+    config->header.version = BIOS_VERSION;
+    return config;
+}
+
+void free_config_dyn(bios_config_dyn_t *config) {
+    free(config);
+}
+
+// Parse a configuration file of any size; settings are read straight into the arena
+int parse_bios_config_dyn(const char *filename, bios_config_dyn_t **config, bios_report_t *report) {
+    *config = NULL;
+
+    STATS_START(open_timer);
+    FILE *file = fopen(filename, "rb");
+    if (!file) {
+        report_message(report, REPORT_ERROR, "Error: Cannot open file %s", filename);
+        return BIOS_ERROR_FILE;
+    }
+    STATS_STOP(STATS_FILE_OPEN, open_timer, 0);
+
+    STATS_START(read_timer);
+    bios_config_header_t header;
+    bios_integrity_ext_t ext;
+    int result = read_config_header(file, filename, &header, &ext, report);
+    if (result != BIOS_SUCCESS) {
+        fclose(file);
+        return result;
+    }
+
+    bios_config_dyn_t *loaded = create_config_dyn(header.num_settings);
+    if (!loaded) {
+        fclose(file);
+        report_message(report, REPORT_ERROR, "Error: Cannot allocate %d settings", header.num_settings);
+        return BIOS_ERROR_FORMAT;
+    }
+    loaded->header = header;
+    loaded->integrity = ext.algorithm;
+    loaded->setting_count = header.num_settings;
+
+    if (header.version == BIOS_VERSION_COMPACT) {
+        result = read_compact_settings(file, filename, &loaded->header, loaded->settings, loaded->setting_count, report);
+        if (result != BIOS_SUCCESS) {
+            fclose(file);
+            free_config_dyn(loaded);
+            return result;
+        }
+    } else if (fread(loaded->settings, sizeof(bios_setting_t), loaded->setting_count, file) != (size_t)loaded->setting_count) {
+        fclose(file);
+        free_config_dyn(loaded);
+        report_message(report, REPORT_ERROR, "Error: Cannot read settings from %s", filename);
+        return BIOS_ERROR_FORMAT;
+    }
+    fclose(file);
+    STATS_STOP(STATS_FILE_READ, read_timer, sizeof(bios_config_header_t) + sizeof(bios_setting_t) * loaded->setting_count);
+
+    rebuild_index_dyn(loaded);
+    result = verify_config_integrity(&loaded->header, &ext, loaded->settings, loaded->setting_count,
+                                     &loaded->checksum_stale, report);
+    if (result != BIOS_SUCCESS) {
+        free_config_dyn(loaded);
+        return result;
+    }
+
+    report_message(report, REPORT_INFO, "Successfully loaded configuration: %d settings", loaded->setting_count);
+    *config = loaded;
+    return BIOS_SUCCESS;
+}
+
+int save_bios_config_dyn(const char *filename, const bios_config_dyn_t *config) {
+    return write_config_file(filename, &config->header, config->settings, config->setting_count, config->integrity,
+                             NULL, NULL);
+}
+
+// Append a setting, doubling the arena when it is full
+int add_setting_dyn(bios_config_dyn_t **config, const bios_setting_t *setting) {
+    bios_config_dyn_t *current = *config;
+
+    if (find_setting_index_dyn(current, setting->name) >= 0) {
+        return BIOS_ERROR_INVALID_SETTING;
+    }
+
+    if (current->setting_count == current->setting_capacity) {
+        if (current->setting_capacity >= MAX_DYN_SETTINGS) {
+            return BIOS_ERROR_FORMAT;
+        }
+        int capacity = current->setting_capacity * 2;
+        if (capacity > MAX_DYN_SETTINGS) {
+            capacity = MAX_DYN_SETTINGS;
+        }
+        size_t slots = index_slots_for(capacity);
+
+        // Settings keep their offset in the arena; the index moves and is rebuilt
+        bios_config_dyn_t *grown = realloc(current, arena_size(capacity, slots));
+        if (!grown) {
+            return BIOS_ERROR_FILE;
+        }
+        layout_arena(grown, capacity, slots);
+        rebuild_index_dyn(grown);
+        *config = current = grown;
+    }
+
+    int position = current->setting_count++;
+    current->settings[position] = *setting;
+    insert_name_index(current->index_slots, current->index_slot_count, current->settings, position);
+
+    current->header.num_settings = current->setting_count;
+    current->header.data_size = sizeof(bios_setting_t) * current->setting_count;
+    current->header.checksum += calculate_checksum_bytes(setting, sizeof(bios_setting_t));
+    return BIOS_SUCCESS;
+}
+
+int find_setting_index_dyn(const bios_config_dyn_t *config, const char *name) {
+    return lookup_name_index(config->index_slots, config->index_slot_count, config->settings, name);
+}
+
+const bios_setting_t* find_setting_dyn(const bios_config_dyn_t *config, const char *name) {
+    int idx = find_setting_index_dyn(config, name);
+    return idx >= 0 ? &config->settings[idx] : NULL;
+}
+
+int set_setting_dyn(bios_config_dyn_t *config, const char *name, const void *value) {
+    int idx = find_setting_index_dyn(config, name);
+    if (idx < 0) {
+        return BIOS_ERROR_INVALID_SETTING;
+    }
+
+    bios_setting_t *setting = &config->settings[idx];
+    if (config->checksum_stale) {
+        memcpy(setting->data, value, setting->size);
+        config->header.checksum = calculate_checksum_bytes(config->settings, sizeof(bios_setting_t) * config->setting_count);
+        config->checksum_stale = 0;
+    } else {
+        config->header.checksum = update_checksum_bytes(config->header.checksum, setting->data, value, setting->size);
+        memcpy(setting->data, value, setting->size);
+    }
+    return BIOS_SUCCESS;
+}
+
+// Copy into the fixed container; fails if it has more than MAX_SETTINGS settings
+int config_dyn_to_fixed(const bios_config_dyn_t *config, bios_config_t *fixed) {
+    if (config->setting_count > MAX_SETTINGS) {
+        return BIOS_ERROR_FORMAT;
+    }
+
+    memset(fixed, 0, sizeof(bios_config_t));
+    fixed->header = config->header;
+    memcpy(fixed->settings, config->settings, sizeof(bios_setting_t) * config->setting_count);
+    fixed->setting_count = config->setting_count;
+    fixed->checksum_stale = config->checksum_stale;
+    fixed->integrity = config->integrity;
+    rebuild_setting_index(fixed);
+    return BIOS_SUCCESS;
+}
+
+bios_config_dyn_t* config_dyn_from_fixed(const bios_config_t *fixed) {
+    bios_config_dyn_t *config = create_config_dyn(fixed->setting_count);
+    if (!config) {
+        return NULL;
+    }
+
+    config->header = fixed->header;
+    memcpy(config->settings, fixed->settings, sizeof(bios_setting_t) * fixed->setting_count);
+    config->setting_count = fixed->setting_count;
+    config->checksum_stale = fixed->checksum_stale;
+    config->integrity = fixed->integrity;
+    rebuild_index_dyn(config);
+    return config;
+}
\ No newline at end of file
@@ -0,0 +1,369 @@
+#include "../include/config_export.h"
+#include "../include/config_parser.h"
+#include "../include/thread_pool.h"
+
+#define EXPORT_CHUNK_FILES 256          // Files parsed in parallel before being written in order
+#define EXPORT_RECORD_RESERVE 128       // Record framing, excluding source and settings
+#define EXPORT_SETTING_RESERVE 320      // Worst case for one escaped setting
+
+static const char digit_pairs[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+// Decimal digits of value at out; returns the end
+static char* format_uint32(char *out, uint32_t value) {
+    char digits[10];
+    char *end = digits + sizeof(digits);
+    char *start = end;
+
+    while (value >= 100) {
+        const char *pair = &digit_pairs[(value % 100) * 2];
+        value /= 100;
+        start -= 2;
+        start[0] = pair[0];
+        start[1] = pair[1];
+    }
+    if (value >= 10) {
+        start -= 2;
+        start[0] = digit_pairs[value * 2];
+        start[1] = digit_pairs[value * 2 + 1];
+    } else {
+        *--start = (char)('0' + value);
+    }
+
+    memcpy(out, start, (size_t)(end - start));
+    return out + (end - start);
+}
+
+static char* append_text(char *out, const char *text, size_t length) {
+    memcpy(out, text, length);
+    return out + length;
+}
+
+#define APPEND_LITERAL(out, literal) append_text((out), (literal), sizeof(literal) - 1)
+
+// JSON string body; bytes from the file are not trusted to be printable
+static char* append_json_string(char *out, const char *text, size_t length) {
+    static const char hex[] = "0123456789abcdef";
+    *out++ = '"';
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = (unsigned char)text[i];
+        if (c == '"' || c == '\\') {
+            *out++ = '\\';
+            *out++ = (char)c;
+        } else if (c < 0x20) {
+            out = APPEND_LITERAL(out, "\\u00");
+            *out++ = hex[c >> 4];
+            *out++ = hex[c & 0xF];
+        } else {
+            *out++ = (char)c;
+        }
+    }
+    *out++ = '"';
+    return out;
+}
+
+// CSV field, quoted only when it contains a separator, quote or line break
+static char* append_csv_field(char *out, const char *text, size_t length) {
+    int needs_quotes = 0;
+    for (size_t i = 0; i < length && !needs_quotes; i++) {
+        char c = text[i];
+        needs_quotes = c == ',' || c == '"' || c == '\n' || c == '\r';
+    }
+    if (!needs_quotes) {
+        return append_text(out, text, length);
+    }
+
+    *out++ = '"';
+    for (size_t i = 0; i < length; i++) {
+        if (text[i] == '"') {
+            *out++ = '"';
+        }
+        *out++ = text[i];
+    }
+    *out++ = '"';
+    return out;
+}
+
+static size_t string_length(const char *text, size_t max_length) {
+    const char *end = memchr(text, '\0', max_length);
+    return end ? (size_t)(end - text) : max_length;
+}
+
+// Numeric value of an integer or boolean setting (the data bytes are unaligned)
+static uint32_t setting_number(const bios_setting_t *setting) {
+    switch (setting->type) {
+        case BIOS_TYPE_UINT8:
+        case BIOS_TYPE_BOOL:
+            return setting->data[0];
+        case BIOS_TYPE_UINT16: {
+            uint16_t value;
+            memcpy(&value, setting->data, sizeof(value));
+            return value;
+        }
+        default: {
+            uint32_t value;
+            memcpy(&value, setting->data, sizeof(value));
+            return value;
+        }
+    }
+}
+
+static size_t string_setting_length(const bios_setting_t *setting) {
+    size_t size = setting->size < MAX_SETTING_DATA ? setting->size : MAX_SETTING_DATA;
+    return string_length((const char*)setting->data, size);
+}
+
+int parse_export_format(const char *name, export_format_t *format) {
+    if (strcmp(name, "jsonl") == 0 || strcmp(name, "json") == 0) {
+        *format = EXPORT_FORMAT_JSONL;
+    } else if (strcmp(name, "csv") == 0) {
+        *format = EXPORT_FORMAT_CSV;
+    } else {
+        printf("Error: Unknown export format '%s' (use jsonl or csv)\n", name);
+        return BIOS_ERROR_INVALID_SETTING;
+    }
+    return BIOS_SUCCESS;
+}
+
+int open_config_exporter(config_exporter_t *exporter, FILE *out, export_format_t format, size_t buffer_size) {
+    memset(exporter, 0, sizeof(config_exporter_t));
+    if (buffer_size == 0) {
+        buffer_size = EXPORT_DEFAULT_BUFFER;
+    } else if (buffer_size < EXPORT_MIN_BUFFER) {
+        buffer_size = EXPORT_MIN_BUFFER;
+    }
+
+    exporter->buffer = malloc(buffer_size);
+    if (!exporter->buffer) {
+        printf("Error: Cannot allocate export buffer\n");
+        return BIOS_ERROR_FILE;
+    }
+    exporter->out = out;
+    exporter->format = format;
+    exporter->capacity = buffer_size;
+    return BIOS_SUCCESS;
+}
+
+int flush_config_exporter(config_exporter_t *exporter) {
+    if (exporter->failed) {
+        return BIOS_ERROR_FILE;
+    }
+    if (exporter->used > 0) {
+        if (fwrite(exporter->buffer, 1, exporter->used, exporter->out) != exporter->used) {
+            printf("Error: Cannot write export output\n");
+            exporter->failed = 1;
+            return BIOS_ERROR_FILE;
+        }
+        exporter->bytes_written += exporter->used;
+        exporter->used = 0;
+    }
+    return BIOS_SUCCESS;
+}
+
+// Make room for bytes more output; the buffer is always far larger than one piece
+static char* reserve_output(config_exporter_t *exporter, size_t bytes) {
+    if (exporter->used + bytes > exporter->capacity && flush_config_exporter(exporter) != BIOS_SUCCESS) {
+        return NULL;
+    }
+    return exporter->failed ? NULL : exporter->buffer + exporter->used;
+}
+
+static char* append_json_value(char *out, const bios_setting_t *setting) {
+    switch (setting->type) {
+        case BIOS_TYPE_UINT8:
+        case BIOS_TYPE_UINT16:
+        case BIOS_TYPE_UINT32:
+            return format_uint32(out, setting_number(setting));
+        case BIOS_TYPE_BOOL:
+            // Only 0 and 1 are booleans; any other stored byte is exported as is, like CSV does
+            if (setting->data[0] > 1) {
+                return format_uint32(out, setting->data[0]);
+            }
+            return setting->data[0] ? APPEND_LITERAL(out, "true") : APPEND_LITERAL(out, "false");
+        case BIOS_TYPE_STRING:
+            return append_json_string(out, (const char*)setting->data, string_setting_length(setting));
+        default:
+            return APPEND_LITERAL(out, "null");
+    }
+}
+
+static int export_jsonl(config_exporter_t *exporter, const char *source, size_t source_length,
+                        const bios_config_t *config) {
+    char *out = reserve_output(exporter, EXPORT_RECORD_RESERVE + source_length * 6);
+    if (!out) {
+        return BIOS_ERROR_FILE;
+    }
+    out = APPEND_LITERAL(out, "{\"source\":");
+    out = append_json_string(out, source, source_length);
+    out = APPEND_LITERAL(out, ",\"version\":");
+    out = format_uint32(out, config->header.version);
+    out = APPEND_LITERAL(out, ",\"checksum\":");
+    out = format_uint32(out, config->header.checksum);
+    out = config->checksum_stale ? APPEND_LITERAL(out, ",\"checksum_ok\":false")
+                                 : APPEND_LITERAL(out, ",\"checksum_ok\":true");
+    out = APPEND_LITERAL(out, ",\"settings\":{");
+    exporter->used = (size_t)(out - exporter->buffer);
+
+    for (int i = 0; i < config->setting_count; i++) {
+        const bios_setting_t *setting = &config->settings[i];
+        out = reserve_output(exporter, EXPORT_SETTING_RESERVE);
+        if (!out) {
+            return BIOS_ERROR_FILE;
+        }
+        if (i > 0) {
+            *out++ = ',';
+        }
+        out = append_json_string(out, setting->name, string_length(setting->name, MAX_SETTING_NAME));
+        *out++ = ':';
+        out = append_json_value(out, setting);
+        exporter->used = (size_t)(out - exporter->buffer);
+    }
+
+    out = reserve_output(exporter, 3);
+    if (!out) {
+        return BIOS_ERROR_FILE;
+    }
+    out = APPEND_LITERAL(out, "}}\n");
+    exporter->used = (size_t)(out - exporter->buffer);
+    return BIOS_SUCCESS;
+}
+
+static int export_csv(config_exporter_t *exporter, const char *source, size_t source_length,
+                      const bios_config_t *config) {
+    char *out;
+    if (!exporter->header_written) {
+        out = reserve_output(exporter, EXPORT_RECORD_RESERVE);
+        if (!out) {
+            return BIOS_ERROR_FILE;
+        }
+        out = APPEND_LITERAL(out, "source,setting,category,type,value,min,max\n");
+        exporter->used = (size_t)(out - exporter->buffer);
+        exporter->header_written = 1;
+    }
+
+    // Quote the source once; every row repeats it
+    char quoted_source[EXPORT_SOURCE_MAX * 2 + 2];
+    size_t quoted_length = (size_t)(append_csv_field(quoted_source, source, source_length) - quoted_source);
+
+    for (int i = 0; i < config->setting_count; i++) {
+        const bios_setting_t *setting = &config->settings[i];
+        out = reserve_output(exporter, quoted_length + EXPORT_SETTING_RESERVE);
+        if (!out) {
+            return BIOS_ERROR_FILE;
+        }
+        out = append_text(out, quoted_source, quoted_length);
+        *out++ = ',';
+        out = append_csv_field(out, setting->name, string_length(setting->name, MAX_SETTING_NAME));
+        *out++ = ',';
+        const char *category = get_category_name((bios_category_t)setting->category);
+        out = append_csv_field(out, category, strlen(category));
+        *out++ = ',';
+        const char *type = get_type_name((bios_data_type_t)setting->type);
+        out = append_text(out, type, strlen(type));
+        *out++ = ',';
+        switch (setting->type) {
+            case BIOS_TYPE_UINT8:
+            case BIOS_TYPE_UINT16:
+            case BIOS_TYPE_UINT32:
+            case BIOS_TYPE_BOOL:
+                out = format_uint32(out, setting_number(setting));
+                break;
+            case BIOS_TYPE_STRING:
+                out = append_csv_field(out, (const char*)setting->data, string_setting_length(setting));
+                break;
+            default:
+                break;
+        }
+        *out++ = ',';
+        out = format_uint32(out, setting->min_value);
+        *out++ = ',';
+        out = format_uint32(out, setting->max_value);
+        *out++ = '\n';
+        exporter->used = (size_t)(out - exporter->buffer);
+    }
+    return BIOS_SUCCESS;
+}
+
+int export_config(config_exporter_t *exporter, const char *source, const bios_config_t *config) {
+    if (!source) {
+        source = "";
+    }
+    size_t source_length = string_length(source, EXPORT_SOURCE_MAX);
+
+    int result = exporter->format == EXPORT_FORMAT_CSV ? export_csv(exporter, source, source_length, config)
+                                                       : export_jsonl(exporter, source, source_length, config);
+    if (result == BIOS_SUCCESS) {
+        exporter->record_count++;
+    }
+    return result;
+}
+
+int close_config_exporter(config_exporter_t *exporter) {
+    int result = flush_config_exporter(exporter);
+    if (result == BIOS_SUCCESS && fflush(exporter->out) != 0) {
+        printf("Error: Cannot write export output\n");
+        result = BIOS_ERROR_FILE;
+    }
+    free(exporter->buffer);
+    exporter->buffer = NULL;
+    exporter->used = exporter->capacity = 0;
+    return result;
+}
+
+// Fleet driver
+
+typedef struct {
+    const fleet_paths_t *paths;
+    size_t first;                       // Path index of configs[0]
+    bios_config_t *configs;
+    int *results;
+} export_chunk_t;
+
+static void parse_export_file(void *context, size_t index, int worker) {
+    export_chunk_t *chunk = context;
+    bios_report_t report;
+    (void)worker;
+
+    init_report(&report);
+    chunk->results[index] = parse_bios_config_report(chunk->paths->paths[chunk->first + index],
+                                                     &chunk->configs[index], &report);
+}
+
+int export_fleet(const fleet_paths_t *paths, int thread_count, config_exporter_t *exporter, size_t *failed_count) {
+    export_chunk_t chunk;
+    chunk.paths = paths;
+    chunk.configs = malloc(sizeof(bios_config_t) * EXPORT_CHUNK_FILES);
+    chunk.results = malloc(sizeof(int) * EXPORT_CHUNK_FILES);
+    if (!chunk.configs || !chunk.results) {
+        free(chunk.configs);
+        free(chunk.results);
+        printf("Error: Cannot allocate export state\n");
+        return BIOS_ERROR_FILE;
+    }
+
+    *failed_count = 0;
+    int result = BIOS_SUCCESS;
+    for (chunk.first = 0; chunk.first < paths->count && result == BIOS_SUCCESS; chunk.first += EXPORT_CHUNK_FILES) {
+        size_t count = paths->count - chunk.first;
+        if (count > EXPORT_CHUNK_FILES) {
+            count = EXPORT_CHUNK_FILES;
+        }
+
+        result = run_thread_pool(count, thread_count, parse_export_file, &chunk);
+        for (size_t i = 0; i < count && result == BIOS_SUCCESS; i++) {
+            if (chunk.results[i] != BIOS_SUCCESS) {
+                (*failed_count)++;
+                continue;
+            }
+            result = export_config(exporter, paths->paths[chunk.first + i], &chunk.configs[i]);
+        }
+    }
+
+    free(chunk.configs);
+    free(chunk.results);
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,851 @@
+#include "../include/config_import.h"
+#include "../include/config_parser.h"
+#include "../include/validator.h"
+#include "../include/atomic_save.h"
+#include <stdarg.h>
+
+#ifdef _WIN32
+#define PATH_SEPARATOR "\\"
+#else
+#define PATH_SEPARATOR "/"
+#endif
+
+#define IMPORT_VALUE_MAX 64         // Longest unquoted INI value
+#define IMPORT_MAX_DEPTH 16         // Nesting allowed inside skipped JSON values
+
+typedef enum {
+    IMPORT_VALUE_TEXT,              // Unquoted INI value, converted per setting type
+    IMPORT_VALUE_NUMBER,
+    IMPORT_VALUE_BOOL,
+    IMPORT_VALUE_STRING,
+    IMPORT_VALUE_INVALID            // JSON null, negative or fractional numbers, arrays, objects
+} import_value_kind_t;
+
+typedef struct {
+    import_value_kind_t kind;
+    uint32_t number;
+    char text[IMPORT_VALUE_MAX + 1];
+    size_t length;                  // Decoded length; may exceed the text buffer
+} import_value_t;
+
+// One pass over one record; nothing is allocated
+typedef struct {
+    const char *text;
+    const char *pos;
+    const char *end;
+    size_t first_line;              // Line number of text[0]
+    config_importer_t *importer;
+    bios_config_t *config;
+    bios_report_t *report;
+    uint64_t assigned;              // Bit per setting index, to catch duplicates
+    int error_count;
+    int format_error;
+} import_parser_t;
+
+// Diagnostics
+
+static unsigned long import_line(const import_parser_t *parser, const char *at) {
+    unsigned long line = (unsigned long)parser->first_line;
+    for (const char *p = parser->text; p < at; p++) {
+        line += *p == '\n';
+    }
+    return line;
+}
+
+static void import_message(import_parser_t *parser, report_severity_t severity, const char *at,
+                           const char *format, ...) __attribute__((format(printf, 4, 5)));
+
+static void import_message(import_parser_t *parser, report_severity_t severity, const char *at,
+                           const char *format, ...) {
+    char message[REPORT_MESSAGE_LEN];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+
+    if (severity == REPORT_ERROR) {
+        parser->error_count++;
+        report_message(parser->report, REPORT_ERROR, "Error: line %lu: %s", import_line(parser, at), message);
+    } else {
+        report_message(parser->report, severity, "Warning: line %lu: %s", import_line(parser, at), message);
+    }
+}
+
+static void import_syntax_error(import_parser_t *parser, const char *at, const char *expected) {
+    parser->format_error = 1;
+    import_message(parser, REPORT_ERROR, at, "Expected %s", expected);
+}
+
+// Applying values
+
+static int convert_value(const bios_setting_t *setting, const import_value_t *value, uint32_t *number) {
+    switch (value->kind) {
+        case IMPORT_VALUE_TEXT:
+            return value->length <= IMPORT_VALUE_MAX ? parse_setting_text(setting, value->text, number)
+                                                     : BIOS_ERROR_INVALID_SETTING;
+        case IMPORT_VALUE_NUMBER:
+            *number = value->number;
+            return BIOS_SUCCESS;
+        case IMPORT_VALUE_BOOL:
+            *number = value->number;
+            return setting->type == BIOS_TYPE_BOOL ? BIOS_SUCCESS : BIOS_ERROR_INVALID_SETTING;
+        default:
+            return BIOS_ERROR_INVALID_SETTING;
+    }
+}
+
+static void assign_setting(import_parser_t *parser, const char *name, size_t name_length,
+                           const import_value_t *value, const char *at) {
+    // Over-long names were truncated and names with an embedded NUL cannot match
+    int index = (name_length < MAX_SETTING_NAME && strlen(name) == name_length) ?
+                find_setting_index(parser->config, name) : -1;
+    if (index < 0) {
+        import_message(parser, REPORT_ERROR, at, "Unknown setting %.40s", name);
+        return;
+    }
+    const bios_setting_t *setting = &parser->config->settings[index];
+    uint8_t data[MAX_SETTING_DATA];
+    if (setting->type == BIOS_TYPE_STRING) {
+        size_t capacity = setting->size < MAX_SETTING_DATA ? setting->size : MAX_SETTING_DATA;
+        if ((value->kind != IMPORT_VALUE_STRING && value->kind != IMPORT_VALUE_TEXT) || value->length > capacity) {
+            import_message(parser, REPORT_ERROR, at, "%s expects text of at most %lu bytes", name,
+                           (unsigned long)capacity);
+            return;
+        }
+        memset(data, 0, sizeof(data));
+        memcpy(data, value->text, value->length);
+    } else {
+        uint32_t number;
+        if (convert_value(setting, value, &number) != BIOS_SUCCESS) {
+            import_message(parser, REPORT_ERROR, at, "Invalid value for %s", name);
+            return;
+        }
+        if (encode_setting_value(setting, number, data) != BIOS_SUCCESS ||
+            validate_setting_value(setting, data) != BIOS_SUCCESS) {
+            import_message(parser, REPORT_ERROR, at, "%s value %u out of range (%u-%u)", name, number,
+                           setting->min_value, setting->max_value);
+            return;
+        }
+    }
+
+    if (parser->assigned & ((uint64_t)1 << index)) {
+        import_message(parser, REPORT_WARNING, at, "%s set more than once, last value kept", name);
+    }
+    parser->assigned |= (uint64_t)1 << index;
+    set_setting_by_name(parser->config, name, data);
+}
+
+// JSON
+
+static void skip_json_space(import_parser_t *parser) {
+    while (parser->pos < parser->end &&
+           (*parser->pos == ' ' || *parser->pos == '\t' || *parser->pos == '\n' || *parser->pos == '\r')) {
+        parser->pos++;
+    }
+}
+
+static int hex_digit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static void store_byte(char *out, size_t capacity, size_t *length, char c) {
+    if (*length < capacity) {
+        out[*length] = c;
+    }
+    (*length)++;
+}
+
+// Decode a string at pos into out (capacity bytes, then NUL); *length is the full decoded length
+static int parse_json_string(import_parser_t *parser, char *out, size_t capacity, size_t *length) {
+    const char *start = parser->pos++;
+    *length = 0;
+    while (parser->pos < parser->end && *parser->pos != '"') {
+        unsigned char c = (unsigned char)*parser->pos++;
+        if (c < 0x20) {
+            import_syntax_error(parser, start, "closing quote");
+            return BIOS_ERROR_FORMAT;
+        }
+        if (c != '\\') {
+            store_byte(out, capacity, length, (char)c);
+            continue;
+        }
+        if (parser->pos >= parser->end) {
+            break;
+        }
+        char escape = *parser->pos++;
+        switch (escape) {
+            case '"': case '\\': case '/': store_byte(out, capacity, length, escape); break;
+            case 'b': store_byte(out, capacity, length, '\b'); break;
+            case 'f': store_byte(out, capacity, length, '\f'); break;
+            case 'n': store_byte(out, capacity, length, '\n'); break;
+            case 'r': store_byte(out, capacity, length, '\r'); break;
+            case 't': store_byte(out, capacity, length, '\t'); break;
+            case 'u': {
+                unsigned code = 0;
+                for (int i = 0; i < 4; i++) {
+                    int digit = parser->pos < parser->end ? hex_digit(*parser->pos++) : -1;
+                    if (digit < 0) {
+                        import_syntax_error(parser, parser->pos, "four hex digits after \\u");
+                        return BIOS_ERROR_FORMAT;
+                    }
+                    code = code << 4 | (unsigned)digit;
+                }
+                if (code >= 0xD800 && code <= 0xDFFF) {
+                    import_syntax_error(parser, parser->pos, "a character outside the surrogate range");
+                    return BIOS_ERROR_FORMAT;
+                }
+                // Stored as UTF-8
+                if (code < 0x80) {
+                    store_byte(out, capacity, length, (char)code);
+                } else if (code < 0x800) {
+                    store_byte(out, capacity, length, (char)(0xC0 | code >> 6));
+                    store_byte(out, capacity, length, (char)(0x80 | (code & 0x3F)));
+                } else {
+                    store_byte(out, capacity, length, (char)(0xE0 | code >> 12));
+                    store_byte(out, capacity, length, (char)(0x80 | ((code >> 6) & 0x3F)));
+                    store_byte(out, capacity, length, (char)(0x80 | (code & 0x3F)));
+                }
+                break;
+            }
+            default:
+                import_syntax_error(parser, parser->pos, "a valid escape sequence");
+                return BIOS_ERROR_FORMAT;
+        }
+    }
+    if (parser->pos >= parser->end) {
+        import_syntax_error(parser, start, "closing quote");
+        return BIOS_ERROR_FORMAT;
+    }
+    parser->pos++;
+    out[*length < capacity ? *length : capacity] = '\0';
+    return BIOS_SUCCESS;
+}
+
+static int match_literal(import_parser_t *parser, const char *literal) {
+    size_t length = strlen(literal);
+    if ((size_t)(parser->end - parser->pos) < length || memcmp(parser->pos, literal, length) != 0) {
+        import_syntax_error(parser, parser->pos, "a value");
+        return BIOS_ERROR_FORMAT;
+    }
+    parser->pos += length;
+    return BIOS_SUCCESS;
+}
+
+// Numbers that fit a setting are non-negative integers; anything else is consumed and marked invalid
+static int parse_json_number(import_parser_t *parser, import_value_t *value) {
+    const char *start = parser->pos;
+    uint64_t number = 0;
+    int valid = 1;
+
+    if (*parser->pos == '-') {
+        valid = 0;
+        parser->pos++;
+    }
+    const char *digits = parser->pos;
+    while (parser->pos < parser->end && *parser->pos >= '0' && *parser->pos <= '9') {
+        number = number * 10 + (uint64_t)(*parser->pos++ - '0');
+        if (number > UINT32_MAX) {
+            valid = 0;
+            number = UINT32_MAX;
+        }
+    }
+    if (parser->pos == digits) {
+        import_syntax_error(parser, start, "a value");
+        return BIOS_ERROR_FORMAT;
+    }
+    while (parser->pos < parser->end && (*parser->pos == '.' || *parser->pos == 'e' || *parser->pos == 'E' ||
+                                         *parser->pos == '+' || *parser->pos == '-' ||
+                                         (*parser->pos >= '0' && *parser->pos <= '9'))) {
+        valid = 0;
+        parser->pos++;
+    }
+
+    value->kind = valid ? IMPORT_VALUE_NUMBER : IMPORT_VALUE_INVALID;
+    value->number = (uint32_t)number;
+    return BIOS_SUCCESS;
+}
+
+static int skip_json_value(import_parser_t *parser, int depth);
+
+static int skip_json_container(import_parser_t *parser, int depth) {
+    char close = *parser->pos == '{' ? '}' : ']';
+    if (depth >= IMPORT_MAX_DEPTH) {
+        import_syntax_error(parser, parser->pos, "less deeply nested values");
+        return BIOS_ERROR_FORMAT;
+    }
+    parser->pos++;
+    skip_json_space(parser);
+    if (parser->pos < parser->end && *parser->pos == close) {
+        parser->pos++;
+        return BIOS_SUCCESS;
+    }
+
+    while (1) {
+        if (close == '}') {
+            char key[1];
+            size_t length;
+            skip_json_space(parser);
+            if (parser->pos >= parser->end || *parser->pos != '"') {
+                import_syntax_error(parser, parser->pos, "a quoted name");
+                return BIOS_ERROR_FORMAT;
+            }
+            if (parse_json_string(parser, key, 0, &length) != BIOS_SUCCESS) {
+                return BIOS_ERROR_FORMAT;
+            }
+            skip_json_space(parser);
+            if (parser->pos >= parser->end || *parser->pos != ':') {
+                import_syntax_error(parser, parser->pos, "':'");
+                return BIOS_ERROR_FORMAT;
+            }
+            parser->pos++;
+        }
+        if (skip_json_value(parser, depth + 1) != BIOS_SUCCESS) {
+            return BIOS_ERROR_FORMAT;
+        }
+        skip_json_space(parser);
+        if (parser->pos < parser->end && *parser->pos == ',') {
+            parser->pos++;
+            continue;
+        }
+        if (parser->pos < parser->end && *parser->pos == close) {
+            parser->pos++;
+            return BIOS_SUCCESS;
+        }
+        import_syntax_error(parser, parser->pos, close == '}' ? "',' or '}'" : "',' or ']'");
+        return BIOS_ERROR_FORMAT;
+    }
+}
+
+// Read one value; containers are skipped and marked invalid
+static int parse_json_value(import_parser_t *parser, import_value_t *value, int depth) {
+    skip_json_space(parser);
+    value->kind = IMPORT_VALUE_INVALID;
+    value->length = 0;
+    if (parser->pos >= parser->end) {
+        import_syntax_error(parser, parser->pos, "a value");
+        return BIOS_ERROR_FORMAT;
+    }
+
+    switch (*parser->pos) {
+        case '"':
+            value->kind = IMPORT_VALUE_STRING;
+            return parse_json_string(parser, value->text, IMPORT_VALUE_MAX, &value->length);
+        case 't':
+            value->kind = IMPORT_VALUE_BOOL;
+            value->number = 1;
+            return match_literal(parser, "true");
+        case 'f':
+            value->kind = IMPORT_VALUE_BOOL;
+            value->number = 0;
+            return match_literal(parser, "false");
+        case 'n':
+            return match_literal(parser, "null");
+        case '{':
+        case '[':
+            return skip_json_container(parser, depth);
+        default:
+            return parse_json_number(parser, value);
+    }
+}
+
+static int skip_json_value(import_parser_t *parser, int depth) {
+    import_value_t value;
+    return parse_json_value(parser, &value, depth);
+}
+
+// Keys of exported records that describe the file rather than a setting
+static int is_record_field(const char *key) {
+    return strcmp(key, "version") == 0 || strcmp(key, "checksum") == 0 || strcmp(key, "checksum_ok") == 0;
+}
+
+static int parse_json_object(import_parser_t *parser, int top_level) {
+    skip_json_space(parser);
+    if (parser->pos >= parser->end || *parser->pos != '{') {
+        import_syntax_error(parser, parser->pos, "'{'");
+        return BIOS_ERROR_FORMAT;
+    }
+    parser->pos++;
+    skip_json_space(parser);
+    if (parser->pos < parser->end && *parser->pos == '}') {
+        parser->pos++;
+        return BIOS_SUCCESS;
+    }
+
+    while (1) {
+        char key[MAX_SETTING_NAME + 1];
+        size_t key_length;
+        import_value_t value;
+
+        skip_json_space(parser);
+        const char *key_start = parser->pos;
+        if (parser->pos >= parser->end || *parser->pos != '"') {
+            import_syntax_error(parser, parser->pos, "a quoted setting name");
+            return BIOS_ERROR_FORMAT;
+        }
+        if (parse_json_string(parser, key, MAX_SETTING_NAME, &key_length) != BIOS_SUCCESS) {
+            return BIOS_ERROR_FORMAT;
+        }
+        skip_json_space(parser);
+        if (parser->pos >= parser->end || *parser->pos != ':') {
+            import_syntax_error(parser, parser->pos, "':'");
+            return BIOS_ERROR_FORMAT;
+        }
+        parser->pos++;
+        skip_json_space(parser);
+
+        int result;
+        if (top_level && strcmp(key, "settings") == 0 && parser->pos < parser->end && *parser->pos == '{') {
+            result = parse_json_object(parser, 0);
+        } else if (top_level && strcmp(key, "source") == 0 && parser->pos < parser->end && *parser->pos == '"') {
+            char *source = parser->importer->source;
+            size_t length;
+            result = parse_json_string(parser, source, sizeof(parser->importer->source) - 1, &length);
+        } else if (top_level && is_record_field(key)) {
+            result = skip_json_value(parser, 0);
+        } else {
+            result = parse_json_value(parser, &value, 0);
+            if (result == BIOS_SUCCESS) {
+                assign_setting(parser, key, key_length, &value, key_start);
+            }
+        }
+        if (result != BIOS_SUCCESS) {
+            return result;
+        }
+
+        skip_json_space(parser);
+        if (parser->pos < parser->end && *parser->pos == ',') {
+            parser->pos++;
+            continue;
+        }
+        if (parser->pos < parser->end && *parser->pos == '}') {
+            parser->pos++;
+            return BIOS_SUCCESS;
+        }
+        import_syntax_error(parser, parser->pos, "',' or '}'");
+        return BIOS_ERROR_FORMAT;
+    }
+}
+
+static void parse_json_record(import_parser_t *parser) {
+    if (parse_json_object(parser, 1) != BIOS_SUCCESS) {
+        return;
+    }
+    skip_json_space(parser);
+    if (parser->pos < parser->end) {
+        import_syntax_error(parser, parser->pos, "end of input after the object");
+    }
+}
+
+// INI
+
+static const char* trim_start(const char *start, const char *end) {
+    while (start < end && (*start == ' ' || *start == '\t')) {
+        start++;
+    }
+    return start;
+}
+
+static const char* trim_end(const char *start, const char *end) {
+    while (end > start && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r')) {
+        end--;
+    }
+    return end;
+}
+
+static void parse_ini_line(import_parser_t *parser, const char *line, const char *line_end) {
+    const char *start = trim_start(line, line_end);
+    const char *end = trim_end(start, line_end);
+    if (start == end || *start == '#' || *start == ';') {
+        return;
+    }
+    if (*start == '[') {
+        if (end[-1] != ']') {
+            import_syntax_error(parser, start, "']' to close the section name");
+        }
+        return;
+    }
+
+    const char *equals = memchr(start, '=', (size_t)(end - start));
+    if (!equals) {
+        import_syntax_error(parser, start, "NAME = VALUE");
+        return;
+    }
+
+    char name[MAX_SETTING_NAME + 1];
+    const char *name_end = trim_end(start, equals);
+    size_t name_length = (size_t)(name_end - start);
+    size_t stored = name_length < MAX_SETTING_NAME ? name_length : MAX_SETTING_NAME;
+    memcpy(name, start, stored);
+    name[stored] = '\0';
+
+    import_value_t value;
+    const char *value_start = trim_start(equals + 1, end);
+    const char *value_end = end;
+    if (value_start < end && *value_start == '"') {
+        // Quoted text, taken literally
+        const char *quote = memchr(value_start + 1, '"', (size_t)(end - value_start - 1));
+        const char *rest = quote ? trim_start(quote + 1, end) : end;
+        if (!quote || (rest < end && *rest != '#' && *rest != ';')) {
+            import_syntax_error(parser, value_start, "closing quote at the end of the value");
+            return;
+        }
+        value.kind = IMPORT_VALUE_STRING;
+        value_start++;
+        value_end = quote;
+    } else {
+        // Inline comments need whitespace before them
+        for (const char *p = value_start; p < end; p++) {
+            if ((*p == '#' || *p == ';') && p > value_start && (p[-1] == ' ' || p[-1] == '\t')) {
+                value_end = trim_end(value_start, p);
+                break;
+            }
+        }
+        value.kind = IMPORT_VALUE_TEXT;
+    }
+
+    value.length = (size_t)(value_end - value_start);
+    size_t copied = value.length < IMPORT_VALUE_MAX ? value.length : IMPORT_VALUE_MAX;
+    memcpy(value.text, value_start, copied);
+    value.text[copied] = '\0';
+    assign_setting(parser, name, name_length, &value, start);
+}
+
+static void parse_ini_record(import_parser_t *parser) {
+    const char *line = parser->text;
+    while (line < parser->end) {
+        const char *newline = memchr(line, '\n', (size_t)(parser->end - line));
+        const char *line_end = newline ? newline : parser->end;
+        parse_ini_line(parser, line, line_end);
+        line = line_end + 1;
+    }
+}
+
+// Records
+
+void init_config_importer(config_importer_t *importer) {
+    memset(importer, 0, sizeof(config_importer_t));
+    load_default_config(&importer->defaults);
+}
+
+static int import_record(config_importer_t *importer, const char *text, size_t length, size_t first_line,
+                         bios_config_t *config, bios_report_t *report) {
+    import_parser_t parser;
+    memset(&parser, 0, sizeof(parser));
+
+    // Skip a UTF-8 byte order mark
+    if (length >= 3 && memcmp(text, "\xEF\xBB\xBF", 3) == 0) {
+        text += 3;
+        length -= 3;
+    }
+    parser.text = parser.pos = text;
+    parser.end = text + length;
+    parser.first_line = first_line;
+    parser.importer = importer;
+    parser.config = config;
+    parser.report = report;
+
+    memcpy(config, &importer->defaults, sizeof(bios_config_t));
+    importer->source[0] = '\0';
+
+    skip_json_space(&parser);
+    if (parser.pos < parser.end && *parser.pos == '{') {
+        parse_json_record(&parser);
+    } else {
+        parse_ini_record(&parser);
+    }
+
+    if (parser.format_error) {
+        return BIOS_ERROR_FORMAT;
+    }
+    return parser.error_count ? BIOS_ERROR_INVALID_SETTING : BIOS_SUCCESS;
+}
+
+int import_config_text(config_importer_t *importer, const char *text, size_t length, bios_config_t *config,
+                       bios_report_t *report) {
+    return import_record(importer, text, length, 1, config, report);
+}
+
+int import_config_file(config_importer_t *importer, const char *filename, bios_config_t *config,
+                       bios_report_t *report) {
+    FILE *file = fopen(filename, "rb");
+    if (!file) {
+        report_message(report, REPORT_ERROR, "Error: Cannot open file %s", filename);
+        return BIOS_ERROR_FILE;
+    }
+
+    char *text = malloc(IMPORT_MAX_TEXT + 1);
+    if (!text) {
+        fclose(file);
+        report_message(report, REPORT_ERROR, "Error: Cannot allocate import buffer");
+        return BIOS_ERROR_FILE;
+    }
+    size_t length = fread(text, 1, IMPORT_MAX_TEXT + 1, file);
+    int failed = ferror(file);
+    fclose(file);
+
+    int result;
+    if (failed) {
+        report_message(report, REPORT_ERROR, "Error: Cannot read file %s", filename);
+        result = BIOS_ERROR_FILE;
+    } else if (length > IMPORT_MAX_TEXT) {
+        report_message(report, REPORT_ERROR, "Error: %s is larger than %d bytes", filename, IMPORT_MAX_TEXT);
+        result = BIOS_ERROR_FORMAT;
+    } else {
+        result = import_config_text(importer, text, length, config, report);
+    }
+    free(text);
+    return result;
+}
+
+int compile_config_file(const char *input, const char *output, bios_report_t *report) {
+    config_importer_t importer;
+    bios_config_t config;
+
+    init_config_importer(&importer);
+    int result = import_config_file(&importer, input, &config, report);
+    if (result != BIOS_SUCCESS) {
+        return result;
+    }
+    return save_bios_config_report(output, &config, report);
+}
+
+// Output files claimed so far by one compile, so records whose sources share a base name
+// (rackA/node1.bin, rackB/node1.bin) cannot silently overwrite each other
+typedef struct {
+    char **paths;               // Open addressing, NULL marks an empty slot
+    size_t slot_count;          // Power of two
+    size_t used;
+} output_paths_t;
+
+// Windows and macOS file systems ignore case, so Node1.bin and node1.bin are one file there
+static char fold_path_char(char c) {
+#if defined(_WIN32) || defined(__APPLE__)
+    return (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+#else
+    return c;
+#endif
+}
+
+static uint32_t hash_output_path(const char *path) {
+    uint32_t hash = 2166136261u;
+    for (const char *p = path; *p; p++) {
+        hash = (hash ^ (unsigned char)fold_path_char(*p)) * 16777619u;
+    }
+    return hash;
+}
+
+static int same_output_path(const char *a, const char *b) {
+    while (*a && fold_path_char(*a) == fold_path_char(*b)) {
+        a++;
+        b++;
+    }
+    return fold_path_char(*a) == fold_path_char(*b);
+}
+
+static void free_output_paths(output_paths_t *set) {
+    for (size_t i = 0; i < set->slot_count; i++) {
+        free(set->paths[i]);
+    }
+    free(set->paths);
+    memset(set, 0, sizeof(output_paths_t));
+}
+
+static void insert_output_path(output_paths_t *set, char *path) {
+    size_t slot = hash_output_path(path) & (set->slot_count - 1);
+    while (set->paths[slot]) {
+        slot = (slot + 1) & (set->slot_count - 1);
+    }
+    set->paths[slot] = path;
+    set->used++;
+}
+
+// BIOS_SUCCESS if path was free and is now taken, BIOS_ERROR_INVALID_SETTING if an earlier record has it
+static int claim_output_path(output_paths_t *set, const char *path) {
+    if (set->slot_count) {
+        size_t slot = hash_output_path(path) & (set->slot_count - 1);
+        for (; set->paths[slot]; slot = (slot + 1) & (set->slot_count - 1)) {
+            if (same_output_path(set->paths[slot], path)) {
+                return BIOS_ERROR_INVALID_SETTING;
+            }
+        }
+    }
+
+    // Keep the load at or below one half
+    if ((set->used + 1) * 2 > set->slot_count) {
+        output_paths_t grown;
+        grown.slot_count = set->slot_count ? set->slot_count * 2 : 256;
+        grown.used = 0;
+        grown.paths = calloc(grown.slot_count, sizeof(char*));
+        if (!grown.paths) {
+            return BIOS_ERROR_FILE;
+        }
+        for (size_t i = 0; i < set->slot_count; i++) {
+            if (set->paths[i]) {
+                insert_output_path(&grown, set->paths[i]);
+            }
+        }
+        free(set->paths);
+        *set = grown;
+    }
+
+    char *copy = malloc(strlen(path) + 1);
+    if (!copy) {
+        return BIOS_ERROR_FILE;
+    }
+    strcpy(copy, path);
+    insert_output_path(set, copy);
+    return BIOS_SUCCESS;
+}
+
+// Output file for a JSON Lines record: the source's base name (if use_source), else the line number
+static int record_output_path(const config_importer_t *importer, const char *output_dir, size_t line_number,
+                              int use_source, char *path, size_t size) {
+    const char *name = importer->source;
+    for (const char *p = importer->source; *p; p++) {
+        if (*p == '/' || *p == '\\' || *p == ':') {
+            name = p + 1;
+        }
+    }
+    const char *dot = strrchr(name, '.');
+    int name_length = dot && dot != name ? (int)(dot - name) : (int)strlen(name);
+
+    int written;
+    if (!use_source || name_length == 0 ||
+        (name[0] == '.' && (name_length == 1 || (name_length == 2 && name[1] == '.')))) {
+        written = snprintf(path, size, "%s%srecord%08lu.bin", output_dir, PATH_SEPARATOR, (unsigned long)line_number);
+    } else {
+        written = snprintf(path, size, "%s%s%.*s.bin", output_dir, PATH_SEPARATOR, name_length, name);
+    }
+    return (written < 0 || (size_t)written >= size) ? BIOS_ERROR_FILE : BIOS_SUCCESS;
+}
+
+// Pick and claim the record's output file; a name taken by an earlier record falls back to
+// record<line>.bin, and the record fails if that is taken too
+static int choose_output_path(const config_importer_t *importer, const char *output_dir, size_t line_number,
+                              output_paths_t *claimed, char *path, size_t size, bios_report_t *report) {
+    if (record_output_path(importer, output_dir, line_number, 1, path, size) != BIOS_SUCCESS) {
+        report_message(report, REPORT_ERROR, "Error: line %lu: Output path too long", (unsigned long)line_number);
+        return BIOS_ERROR_FILE;
+    }
+    int result = claim_output_path(claimed, path);
+    if (result != BIOS_ERROR_INVALID_SETTING) {
+        return result;
+    }
+
+    // Messages name files without output_dir, which is the same for every record
+    size_t dir_length = strlen(output_dir) + strlen(PATH_SEPARATOR);
+    char taken[FLEET_PATH_MAX];
+    snprintf(taken, sizeof(taken), "%s", path + dir_length);
+    if (record_output_path(importer, output_dir, line_number, 0, path, size) != BIOS_SUCCESS ||
+        claim_output_path(claimed, path) != BIOS_SUCCESS) {
+        report_message(report, REPORT_ERROR, "Error: line %lu: %s already written by an earlier record",
+                       (unsigned long)line_number, taken);
+        return BIOS_ERROR_INVALID_SETTING;
+    }
+    report_message(report, REPORT_WARNING, "Warning: line %lu: %s already written, saved as %s",
+                   (unsigned long)line_number, taken, path + dir_length);
+    return BIOS_SUCCESS;
+}
+
+static int compile_record(config_importer_t *importer, const char *text, size_t length, size_t line_number,
+                          const char *output_dir, output_paths_t *claimed, save_batch_t *batch) {
+    bios_config_t config;
+    bios_report_t report;
+    char path[FLEET_PATH_MAX];
+
+    init_report(&report);
+    int result = import_record(importer, text, length, line_number, &config, &report);
+    if (result == BIOS_SUCCESS) {
+        result = choose_output_path(importer, output_dir, line_number, claimed, path, sizeof(path), &report);
+    }
+    if (result == BIOS_SUCCESS) {
+        result = save_bios_config_batched(batch, path, &config, &report);
+    }
+    if (result != BIOS_SUCCESS || report.warning_count) {
+        print_report(&report);
+    }
+    return result;
+}
+
+int compile_config_lines(const char *input, const char *output_dir, size_t *compiled_count, size_t *failed_count) {
+    config_importer_t importer;
+    save_batch_t batch;
+    output_paths_t claimed = {0};
+
+    *compiled_count = *failed_count = 0;
+    FILE *file = fopen(input, "rb");
+    if (!file) {
+        printf("Error: Cannot open file %s\n", input);
+        return BIOS_ERROR_FILE;
+    }
+    char *buffer = malloc(IMPORT_MAX_TEXT);
+    if (!buffer) {
+        fclose(file);
+        printf("Error: Cannot allocate import buffer\n");
+        return BIOS_ERROR_FILE;
+    }
+    init_config_importer(&importer);
+    init_save_batch(&batch);
+
+    // Lines are processed in place in one buffer; a partial last line moves to the front
+    size_t used = 0;
+    size_t line_number = 1;
+    int skipping = 0;           // Discarding the rest of an over-long line
+    int at_eof = 0;
+    int read_failed = 0;
+    while (!at_eof) {
+        size_t read = fread(buffer + used, 1, IMPORT_MAX_TEXT - used, file);
+        if (read == 0) {
+            at_eof = 1;
+            if (ferror(file)) {
+                printf("Error: Cannot read file %s\n", input);
+                read_failed = 1;
+                break;
+            }
+        }
+        used += read;
+
+        char *line = buffer;
+        char *end = buffer + used;
+        while (line < end) {
+            char *newline = memchr(line, '\n', (size_t)(end - line));
+            if (!newline && !at_eof) {
+                break;
+            }
+            char *line_end = newline ? newline : end;
+            if (skipping) {
+                skipping = 0;
+            } else if (trim_start(line, trim_end(line, line_end)) < trim_end(line, line_end)) {
+                if (compile_record(&importer, line, (size_t)(line_end - line), line_number, output_dir,
+                                   &claimed, &batch) == BIOS_SUCCESS) {
+                    (*compiled_count)++;
+                } else {
+                    (*failed_count)++;
+                }
+            }
+            line_number++;
+            line = newline ? newline + 1 : end;
+        }
+
+        used = (size_t)(end - line);
+        if (used == IMPORT_MAX_TEXT) {
+            if (!skipping) {
+                printf("Error: line %lu: Record longer than %d bytes\n", (unsigned long)line_number, IMPORT_MAX_TEXT);
+                (*failed_count)++;
+            }
+            skipping = 1;
+            used = 0;
+        } else {
+            memmove(buffer, line, used);
+        }
+    }
+
+    fclose(file);
+    free(buffer);
+    free_output_paths(&claimed);
+    int result = commit_save_batch(&batch, NULL);
+    return (result == BIOS_SUCCESS && !read_failed) ? BIOS_SUCCESS : BIOS_ERROR_FILE;
+}
\ No newline at end of file
@@ -0,0 +1,401 @@
+#include "../include/config_pack.h"
+#include "../include/checksum.h"
+#include <stddef.h>
+
+// Descriptor bytes are everything except the value
+#define DESCRIPTOR_HEAD_SIZE offsetof(bios_setting_t, data)
+#define DESCRIPTOR_TAIL_OFFSET offsetof(bios_setting_t, min_value)
+#define DESCRIPTOR_TAIL_SIZE (sizeof(bios_setting_t) - DESCRIPTOR_TAIL_OFFSET)
+
+typedef struct {
+    uint8_t *out;
+    size_t capacity;
+    size_t position;
+    uint32_t accumulator;
+    int bit_count;
+} bit_writer_t;
+
+typedef struct {
+    const uint8_t *in;
+    size_t size;
+    size_t position;
+    uint32_t accumulator;
+    int bit_count;
+} bit_reader_t;
+
+// Values are written LSB first; count is at most 8
+static int put_bits(bit_writer_t *writer, uint32_t value, int count) {
+    writer->accumulator |= value << writer->bit_count;
+    writer->bit_count += count;
+    while (writer->bit_count >= 8) {
+        if (writer->position >= writer->capacity) {
+            return BIOS_ERROR_FORMAT;
+        }
+        writer->out[writer->position++] = (uint8_t)writer->accumulator;
+        writer->accumulator >>= 8;
+        writer->bit_count -= 8;
+    }
+    return BIOS_SUCCESS;
+}
+
+static int flush_bits(bit_writer_t *writer) {
+    return writer->bit_count > 0 ? put_bits(writer, 0, 8 - writer->bit_count) : BIOS_SUCCESS;
+}
+
+static int get_bits(bit_reader_t *reader, int count, uint32_t *value) {
+    while (reader->bit_count < count) {
+        if (reader->position >= reader->size) {
+            return BIOS_ERROR_FORMAT;
+        }
+        reader->accumulator |= (uint32_t)reader->in[reader->position++] << reader->bit_count;
+        reader->bit_count += 8;
+    }
+    *value = reader->accumulator & ((1u << count) - 1);
+    reader->accumulator >>= count;
+    reader->bit_count -= count;
+    return BIOS_SUCCESS;
+}
+
+// Booleans take one bit; everything else its declared size in bytes
+static int is_bit_setting(const bios_setting_t *setting) {
+    return setting->type == BIOS_TYPE_BOOL && setting->size == 1;
+}
+
+static int same_descriptor(const bios_setting_t *a, const bios_setting_t *b) {
+    return memcmp(a, b, DESCRIPTOR_HEAD_SIZE) == 0 &&
+           memcmp((const uint8_t*)a + DESCRIPTOR_TAIL_OFFSET, (const uint8_t*)b + DESCRIPTOR_TAIL_OFFSET,
+                  DESCRIPTOR_TAIL_SIZE) == 0;
+}
+
+void init_pack_dictionary(pack_dictionary_t *dictionary) {
+    dictionary->schemas = NULL;
+    dictionary->count = 0;
+    dictionary->capacity = 0;
+    dictionary->last_match = 0;
+}
+
+void free_pack_dictionary(pack_dictionary_t *dictionary) {
+    free(dictionary->schemas);
+    init_pack_dictionary(dictionary);
+}
+
+// Descriptors must fit the setting they are unpacked into; archives are not trusted
+// to have been written by pack_config_image()
+static int descriptors_valid(const bios_setting_t *settings, int count) {
+    for (int i = 0; i < count; i++) {
+        if (settings[i].size > MAX_SETTING_DATA ||
+            (settings[i].type == BIOS_TYPE_BOOL && settings[i].size != 1)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int add_pack_schema(pack_dictionary_t *dictionary, const bios_setting_t *settings, int count) {
+    if (dictionary->count >= 0xFFFF || !descriptors_valid(settings, count)) {
+        return BIOS_ERROR_FORMAT;
+    }
+    if (dictionary->count == dictionary->capacity) {
+        size_t capacity = dictionary->capacity ? dictionary->capacity * 2 : 4;
+        pack_schema_t *grown = realloc(dictionary->schemas, capacity * sizeof(pack_schema_t));
+        if (!grown) {
+            return BIOS_ERROR_FILE;
+        }
+        dictionary->schemas = grown;
+        dictionary->capacity = capacity;
+    }
+
+    pack_schema_t *schema = &dictionary->schemas[dictionary->count];
+    schema->setting_count = count;
+    memcpy(schema->settings, settings, sizeof(bios_setting_t) * count);
+    for (int i = 0; i < count; i++) {
+        memset(schema->settings[i].data, 0, MAX_SETTING_DATA);
+    }
+    return (int)dictionary->count++;
+}
+
+// Schema id for a settings layout, adding it when it is new
+static int find_pack_schema(pack_dictionary_t *dictionary, const bios_setting_t *settings, int count) {
+    for (size_t n = 0; n < dictionary->count; n++) {
+        size_t id = (dictionary->last_match + n) % dictionary->count;
+        const pack_schema_t *schema = &dictionary->schemas[id];
+        if (schema->setting_count != count) {
+            continue;
+        }
+        int i = 0;
+        while (i < count && same_descriptor(&schema->settings[i], &settings[i])) {
+            i++;
+        }
+        if (i == count) {
+            dictionary->last_match = id;
+            return (int)id;
+        }
+    }
+    return add_pack_schema(dictionary, settings, count);
+}
+
+// Dictionary block: u32 schema count, then per schema a u16 setting count and its descriptors
+size_t pack_dictionary_size(const pack_dictionary_t *dictionary) {
+    size_t size = sizeof(uint32_t);
+    for (size_t i = 0; i < dictionary->count; i++) {
+        size += sizeof(uint16_t) + sizeof(bios_setting_t) * dictionary->schemas[i].setting_count;
+    }
+    return size;
+}
+
+void serialize_pack_dictionary(const pack_dictionary_t *dictionary, uint8_t *buffer) {
+    uint32_t schema_count = (uint32_t)dictionary->count;
+    memcpy(buffer, &schema_count, sizeof(schema_count));
+    buffer += sizeof(schema_count);
+
+    for (size_t i = 0; i < dictionary->count; i++) {
+        const pack_schema_t *schema = &dictionary->schemas[i];
+        uint16_t setting_count = (uint16_t)schema->setting_count;
+        memcpy(buffer, &setting_count, sizeof(setting_count));
+        buffer += sizeof(setting_count);
+        memcpy(buffer, schema->settings, sizeof(bios_setting_t) * setting_count);
+        buffer += sizeof(bios_setting_t) * setting_count;
+    }
+}
+
+int load_pack_dictionary(pack_dictionary_t *dictionary, const uint8_t *data, size_t size) {
+    init_pack_dictionary(dictionary);
+
+    uint32_t schema_count;
+    if (size < sizeof(schema_count)) {
+        return BIOS_ERROR_FORMAT;
+    }
+    memcpy(&schema_count, data, sizeof(schema_count));
+    size_t offset = sizeof(schema_count);
+
+    for (uint32_t i = 0; i < schema_count; i++) {
+        uint16_t setting_count;
+        if (size - offset < sizeof(setting_count)) {
+            free_pack_dictionary(dictionary);
+            return BIOS_ERROR_FORMAT;
+        }
+        memcpy(&setting_count, data + offset, sizeof(setting_count));
+        offset += sizeof(setting_count);
+
+        size_t schema_bytes = sizeof(bios_setting_t) * setting_count;
+        if (setting_count > MAX_SETTINGS || size - offset < schema_bytes ||
+            add_pack_schema(dictionary, (const bios_setting_t*)(data + offset), setting_count) < 0) {
+            free_pack_dictionary(dictionary);
+            return BIOS_ERROR_FORMAT;
+        }
+        offset += schema_bytes;
+    }
+    if (offset != size) {
+        free_pack_dictionary(dictionary);
+        return BIOS_ERROR_FORMAT;
+    }
+    return BIOS_SUCCESS;
+}
+
+static int store_raw_record(const uint8_t *image, size_t image_size, uint8_t *packed, size_t capacity,
+                            size_t *packed_size) {
+    if (image_size + 1 > capacity) {
+        return BIOS_ERROR_FORMAT;
+    }
+    packed[0] = PACK_FLAG_RAW;
+    memcpy(packed + 1, image, image_size);
+    *packed_size = image_size + 1;
+    return BIOS_SUCCESS;
+}
+
+// Every value must be reproducible from its packed bits
+static int settings_packable(const bios_setting_t *settings, int count) {
+    for (int i = 0; i < count; i++) {
+        const bios_setting_t *setting = &settings[i];
+        if (!descriptors_valid(setting, 1)) {
+            return 0;
+        }
+        for (int b = setting->size; b < MAX_SETTING_DATA; b++) {
+            if (setting->data[b]) {
+                return 0;
+            }
+        }
+        if (is_bit_setting(setting) && setting->data[0] > 1) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int pack_config_image(pack_dictionary_t *dictionary, const uint8_t *image, size_t image_size,
+                      uint8_t *packed, size_t capacity, size_t *packed_size) {
+    bios_config_header_t header;
+    bios_integrity_ext_t ext = {0};
+    if (image_size < sizeof(header)) {
+        return store_raw_record(image, image_size, packed, capacity, packed_size);
+    }
+    memcpy(&header, image, sizeof(header));
+
+    size_t settings_offset = sizeof(header);
+    if (header.version == BIOS_VERSION_CRC32C) {
+        if (image_size < settings_offset + sizeof(ext)) {
+            return store_raw_record(image, image_size, packed, capacity, packed_size);
+        }
+        memcpy(&ext, image + settings_offset, sizeof(ext));
+        settings_offset += sizeof(ext);
+    }
+
+    int count = header.num_settings;
+    size_t data_size = sizeof(bios_setting_t) * (size_t)count;
+    const bios_setting_t *settings = (const bios_setting_t*)(image + settings_offset);
+    if (memcmp(header.signature, BIOS_SIGNATURE, 4) != 0 || count > MAX_SETTINGS ||
+        image_size != settings_offset + data_size || !settings_packable(settings, count)) {
+        return store_raw_record(image, image_size, packed, capacity, packed_size);
+    }
+
+    // Header and extension are left out when they can be recomputed from the settings
+    int version_ok = header.version == BIOS_VERSION || header.version == BIOS_VERSION_CRC32C;
+    int explicit_header = !version_ok || header.data_size != data_size || header.reserved != 0 ||
+                          header.checksum != calculate_checksum_bytes(settings, data_size);
+    if (header.version == BIOS_VERSION_CRC32C &&
+        (ext.algorithm != BIOS_INTEGRITY_CRC32C || ext.reserved != 0 ||
+         ext.crc32c != checksum_crc32c(0, settings, data_size))) {
+        explicit_header = 1;
+    }
+
+    int schema_id = find_pack_schema(dictionary, settings, count);
+    if (schema_id < 0) {
+        return store_raw_record(image, image_size, packed, capacity, packed_size);
+    }
+
+    bit_writer_t writer = { packed, capacity, 0, 0, 0 };
+    uint8_t flags = 0;
+    if (explicit_header) {
+        flags |= PACK_FLAG_EXPLICIT;
+    } else if (header.version == BIOS_VERSION_CRC32C) {
+        flags |= PACK_FLAG_CRC32C;
+    }
+
+    size_t prefix = 1 + (explicit_header ? settings_offset : 0) + sizeof(uint16_t);
+    if (prefix > capacity) {
+        return BIOS_ERROR_FORMAT;
+    }
+    packed[writer.position++] = flags;
+    if (explicit_header) {
+        memcpy(packed + writer.position, image, settings_offset);
+        writer.position += settings_offset;
+    }
+    uint16_t id = (uint16_t)schema_id;
+    memcpy(packed + writer.position, &id, sizeof(id));
+    writer.position += sizeof(id);
+
+    for (int i = 0; i < count; i++) {
+        const bios_setting_t *setting = &settings[i];
+        int result = BIOS_SUCCESS;
+        if (is_bit_setting(setting)) {
+            result = put_bits(&writer, setting->data[0], 1);
+        } else {
+            for (int b = 0; b < setting->size && result == BIOS_SUCCESS; b++) {
+                result = put_bits(&writer, setting->data[b], 8);
+            }
+        }
+        if (result != BIOS_SUCCESS) {
+            return result;
+        }
+    }
+    if (flush_bits(&writer) != BIOS_SUCCESS) {
+        return BIOS_ERROR_FORMAT;
+    }
+
+    *packed_size = writer.position;
+    return BIOS_SUCCESS;
+}
+
+int unpack_config_image(const pack_dictionary_t *dictionary, const uint8_t *packed, size_t packed_size,
+                        uint8_t *image, size_t capacity, size_t *image_size) {
+    if (packed_size < 1) {
+        return BIOS_ERROR_FORMAT;
+    }
+    uint8_t flags = packed[0];
+    if (flags & PACK_FLAG_RAW) {
+        if (packed_size - 1 > capacity) {
+            return BIOS_ERROR_FORMAT;
+        }
+        memcpy(image, packed + 1, packed_size - 1);
+        *image_size = packed_size - 1;
+        return BIOS_SUCCESS;
+    }
+
+    // Header (and extension) are either stored or rebuilt below
+    bios_config_header_t header;
+    memset(&header, 0, sizeof(header));
+    size_t position = 1;
+    size_t settings_offset = sizeof(header);
+    if (flags & PACK_FLAG_EXPLICIT) {
+        if (packed_size < position + sizeof(header)) {
+            return BIOS_ERROR_FORMAT;
+        }
+        memcpy(&header, packed + position, sizeof(header));
+        if (header.version == BIOS_VERSION_CRC32C) {
+            settings_offset += sizeof(bios_integrity_ext_t);
+        }
+        if (packed_size < position + settings_offset || capacity < settings_offset) {
+            return BIOS_ERROR_FORMAT;
+        }
+        memcpy(image, packed + position, settings_offset);
+        position += settings_offset;
+    } else if (flags & PACK_FLAG_CRC32C) {
+        settings_offset += sizeof(bios_integrity_ext_t);
+    }
+
+    uint16_t schema_id;
+    if (packed_size < position + sizeof(schema_id)) {
+        return BIOS_ERROR_FORMAT;
+    }
+    memcpy(&schema_id, packed + position, sizeof(schema_id));
+    position += sizeof(schema_id);
+    if (schema_id >= dictionary->count) {
+        return BIOS_ERROR_FORMAT;
+    }
+
+    const pack_schema_t *schema = &dictionary->schemas[schema_id];
+    size_t data_size = sizeof(bios_setting_t) * (size_t)schema->setting_count;
+    if (capacity < settings_offset + data_size) {
+        return BIOS_ERROR_FORMAT;
+    }
+
+    // Descriptors come from the schema, values from the packed bits
+    bios_setting_t *settings = (bios_setting_t*)(image + settings_offset);
+    memcpy(settings, schema->settings, data_size);
+    bit_reader_t reader = { packed + position, packed_size - position, 0, 0, 0 };
+    for (int i = 0; i < schema->setting_count; i++) {
+        bios_setting_t *setting = &settings[i];
+        uint32_t value;
+        if (is_bit_setting(setting)) {
+            if (get_bits(&reader, 1, &value) != BIOS_SUCCESS) {
+                return BIOS_ERROR_FORMAT;
+            }
+            setting->data[0] = (uint8_t)value;
+            continue;
+        }
+        for (int b = 0; b < setting->size; b++) {
+            if (get_bits(&reader, 8, &value) != BIOS_SUCCESS) {
+                return BIOS_ERROR_FORMAT;
+            }
+            setting->data[b] = (uint8_t)value;
+        }
+    }
+
+    if (!(flags & PACK_FLAG_EXPLICIT)) {
+        memcpy(header.signature, BIOS_SIGNATURE, 4);
+        header.version = (flags & PACK_FLAG_CRC32C) ? BIOS_VERSION_CRC32C : BIOS_VERSION;
+        header.num_settings = (uint16_t)schema->setting_count;
+        header.data_size = (uint32_t)data_size;
+        header.checksum = calculate_checksum_bytes(settings, data_size);
+        memcpy(image, &header, sizeof(header));
+        if (flags & PACK_FLAG_CRC32C) {
+            bios_integrity_ext_t ext = {0};
+            ext.algorithm = BIOS_INTEGRITY_CRC32C;
+            ext.crc32c = checksum_crc32c(0, settings, data_size);
+            memcpy(image + sizeof(header), &ext, sizeof(ext));
+        }
+    }
+
+    *image_size = settings_offset + data_size;
+    return BIOS_SUCCESS;
+}
\ No newline at end of file
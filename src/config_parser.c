@@ -1,200 +1,443 @@
 #include "../include/config_parser.h"
+#include "../include/checksum.h"
+#include "../include/name_index.h"
+#include "../include/config_compact.h"
+#include "../include/default_config.h"
+#include "../include/stats.h"
+
+// Additive 16-bit checksum over a raw byte range
+uint16_t calculate_checksum_bytes(const void *data, size_t size) {
+    return checksum_sum16(data, size);
+}
+
+// Adjust an additive checksum for bytes replaced in place
+uint16_t update_checksum_bytes(uint16_t checksum, const void *old_data, const void *new_data, size_t size) {
+    return (uint16_t)(checksum - calculate_checksum_bytes(old_data, size) + calculate_checksum_bytes(new_data, size));
+}
 
 // Calculate checksum for data integrity
 uint16_t calculate_checksum(const bios_config_t *config) {
-    uint16_t checksum = 0;
-    const uint8_t *data = (const uint8_t*)config->settings;
+    STATS_START(checksum_timer);
     size_t size = sizeof(bios_setting_t) * config->setting_count;
-    
-    for (size_t i = 0; i < size; i++) {
-        checksum += data[i];
-    }
+    uint16_t checksum = calculate_checksum_bytes(config->settings, size);
+    STATS_STOP(STATS_CHECKSUM, checksum_timer, size);
     return checksum;
 }
 
 // Parse configuration file
 int parse_bios_config(const char *filename, bios_config_t *config) {
-    FILE *file = fopen(filename, "rb");
-    if (!file) {
-        printf("Error: Cannot open file %s\n", filename);
-        return BIOS_ERROR_FILE;
-    }
-    
+    return parse_bios_config_report(filename, config, NULL);
+}
+
+// Read and check the header (and integrity extension) at the start of a file
+int read_config_header(FILE *file, const char *filename, bios_config_header_t *header,
+                       bios_integrity_ext_t *ext, bios_report_t *report) {
     // Read header
-    if (fread(&config->header, sizeof(bios_config_header_t), 1, file) != 1) {
-        fclose(file);
-        printf("Error: Cannot read header from %s\n", filename);
+    if (fread(header, sizeof(bios_config_header_t), 1, file) != 1) {
+        report_message(report, REPORT_ERROR, "Error: Cannot read header from %s", filename);
         return BIOS_ERROR_FORMAT;
     }
     
     // Validate signature
-    if (memcmp(config->header.signature, BIOS_SIGNATURE, 4) != 0) {
-        fclose(file);
-        printf("Error: Invalid BIOS signature\n");
+    if (memcmp(header->signature, BIOS_SIGNATURE, 4) != 0) {
+        report_message(report, REPORT_ERROR, "Error: Invalid BIOS signature");
         return BIOS_ERROR_FORMAT;
     }
     
+    // Read integrity extension
+    memset(ext, 0, sizeof(bios_integrity_ext_t));
+    ext->algorithm = BIOS_INTEGRITY_SUM16;
+    if (header->version == BIOS_VERSION_CRC32C) {
+        if (fread(ext, sizeof(bios_integrity_ext_t), 1, file) != 1) {
+            report_message(report, REPORT_ERROR, "Error: Cannot read integrity data from %s", filename);
+            return BIOS_ERROR_FORMAT;
+        }
+    }
+    return BIOS_SUCCESS;
+}
+
+// Check loaded settings against the stored checksum and CRC32C
+int verify_config_integrity(const bios_config_header_t *header, const bios_integrity_ext_t *ext,
+                            const bios_setting_t *settings, int count, int *checksum_stale,
+                            bios_report_t *report) {
+    STATS_START(checksum_timer);
+    size_t size = sizeof(bios_setting_t) * count;
+    
+    // Validate checksum
+    uint16_t calculated_checksum = calculate_checksum_bytes(settings, size);
+    *checksum_stale = calculated_checksum != header->checksum;
+    if (*checksum_stale) {
+        report_message(report, REPORT_WARNING, "Warning: Checksum mismatch (calculated: %04X, expected: %04X)",
+                       calculated_checksum, header->checksum);
+        // Continue anyway for demo purposes
+    }
+    
+    // Validate CRC32C, a mismatch here is not tolerated
+    if (ext->algorithm == BIOS_INTEGRITY_CRC32C) {
+        uint32_t calculated_crc = checksum_crc32c(0, settings, size);
+        if (calculated_crc != ext->crc32c) {
+            report_message(report, REPORT_ERROR, "Error: CRC32C mismatch (calculated: %08X, expected: %08X)",
+                           calculated_crc, ext->crc32c);
+            STATS_STOP(STATS_CHECKSUM, checksum_timer, size);
+            return BIOS_ERROR_CHECKSUM;
+        }
+    }
+    STATS_STOP(STATS_CHECKSUM, checksum_timer, size);
+    return BIOS_SUCCESS;
+}
+
+// Parse configuration file, collecting diagnostics in report (reentrant when report is non-NULL)
+int parse_bios_config_report(const char *filename, bios_config_t *config, bios_report_t *report) {
+    STATS_START(open_timer);
+    FILE *file = fopen(filename, "rb");
+    if (!file) {
+        report_message(report, REPORT_ERROR, "Error: Cannot open file %s", filename);
+        return BIOS_ERROR_FILE;
+    }
+    STATS_STOP(STATS_FILE_OPEN, open_timer, 0);
+    
+    STATS_START(read_timer);
+    bios_integrity_ext_t ext;
+    int result = read_config_header(file, filename, &config->header, &ext, report);
+    if (result != BIOS_SUCCESS) {
+        fclose(file);
+        return result;
+    }
+    config->integrity = ext.algorithm;
+    
     // Read settings
     config->setting_count = config->header.num_settings;
     if (config->setting_count > MAX_SETTINGS) {
         fclose(file);
-        printf("Error: Too many settings (%d > %d)\n", config->setting_count, MAX_SETTINGS);
+        report_message(report, REPORT_ERROR, "Error: Too many settings (%d > %d), use parse_bios_config_dyn()",
+                       config->setting_count, MAX_SETTINGS);
         return BIOS_ERROR_FORMAT;
     }
     
-    if (fread(config->settings, sizeof(bios_setting_t), config->setting_count, file) != config->setting_count) {
+    if (config->header.version == BIOS_VERSION_COMPACT) {
+        // Compact file: (ID, value) pairs expanded against the schema registry
+        result = read_compact_settings(file, filename, &config->header, config->settings, MAX_SETTINGS, report);
+        if (result != BIOS_SUCCESS) {
+            fclose(file);
+            return result;
+        }
+    } else if (fread(config->settings, sizeof(bios_setting_t), config->setting_count, file) != (size_t)config->setting_count) {
         fclose(file);
-        printf("Error: Cannot read settings from %s\n", filename);
+        report_message(report, REPORT_ERROR, "Error: Cannot read settings from %s", filename);
         return BIOS_ERROR_FORMAT;
     }
     
     fclose(file);
+    STATS_STOP(STATS_FILE_READ, read_timer, sizeof(bios_config_header_t) + sizeof(bios_setting_t) * config->setting_count);
+    rebuild_setting_index(config);
     
-    // Validate checksum
-    uint16_t calculated_checksum = calculate_checksum(config);
-    if (calculated_checksum != config->header.checksum) {
-        printf("Warning: Checksum mismatch (calculated: %04X, expected: %04X)\n", 
-               calculated_checksum, config->header.checksum);
-        // Continue anyway for demo purposes
+    result = verify_config_integrity(&config->header, &ext, config->settings, config->setting_count,
+                                     &config->checksum_stale, report);
+    if (result != BIOS_SUCCESS) {
+        return result;
     }
     
-    printf("Successfully loaded configuration: %d settings\n", config->setting_count);
+    report_message(report, REPORT_INFO, "Successfully loaded configuration: %d settings", config->setting_count);
     return BIOS_SUCCESS;
 }
 
-// Save configuration file
-int save_bios_config(const char *filename, const bios_config_t *config) {
-    FILE *file = fopen(filename, "wb");
-    if (!file) {
-        printf("Error: Cannot create file %s\n", filename);
+// Serialize header, integrity extension and settings, then replace the file atomically
+int write_config_file(const char *filename, const bios_config_header_t *base_header,
+                      const bios_setting_t *settings, int count, int integrity, save_batch_t *batch,
+                      bios_report_t *report) {
+    STATS_START(save_timer);
+    uint8_t stack_image[MAX_CONFIG_IMAGE_SIZE(MAX_SETTINGS)];
+    size_t capacity = MAX_CONFIG_IMAGE_SIZE(count);
+    uint8_t *image = capacity <= sizeof(stack_image) ? stack_image : malloc(capacity);
+    if (!image) {
+        report_message(report, REPORT_ERROR, "Error: Cannot allocate %lu bytes for %s",
+                       (unsigned long)capacity, filename);
         return BIOS_ERROR_FILE;
     }
     
-    // Update header
-    bios_config_header_t header = config->header;
+    size_t image_size;
+    int result = serialize_config_image(base_header, settings, count, integrity, image, capacity, &image_size);
+    if (result == BIOS_SUCCESS) {
+        result = write_file_atomic(filename, image, image_size, batch, report);
+    }
+    if (image != stack_image) {
+        free(image);
+    }
+    if (result != BIOS_SUCCESS) {
+        return result;
+    }
+    
+    STATS_STOP(STATS_SAVE, save_timer, image_size);
+    report_message(report, REPORT_INFO, "Configuration saved to %s", filename);
+    return BIOS_SUCCESS;
+}
+
+// Serialize header, integrity extension and settings into one contiguous image
+int serialize_config_image(const bios_config_header_t *base_header, const bios_setting_t *settings, int count,
+                           int integrity, uint8_t *buffer, size_t capacity, size_t *image_size) {
+    bios_config_header_t header = *base_header;
     memcpy(header.signature, BIOS_SIGNATURE, 4);
-    header.version = BIOS_VERSION;
-    header.num_settings = config->setting_count;
-    header.data_size = sizeof(bios_setting_t) * config->setting_count;
-    header.checksum = calculate_checksum(config);
+    header.version = integrity == BIOS_INTEGRITY_CRC32C ? BIOS_VERSION_CRC32C : BIOS_VERSION;
+    header.num_settings = count;
+    header.data_size = sizeof(bios_setting_t) * count;
+    header.checksum = calculate_checksum_bytes(settings, header.data_size);
     
-    // Write header
-    if (fwrite(&header, sizeof(bios_config_header_t), 1, file) != 1) {
-        fclose(file);
-        printf("Error: Cannot write header to %s\n", filename);
-        return BIOS_ERROR_FILE;
+    size_t size = sizeof(bios_config_header_t) + header.data_size;
+    if (header.version == BIOS_VERSION_CRC32C) {
+        size += sizeof(bios_integrity_ext_t);
+    }
+    if (size > capacity) {
+        return BIOS_ERROR_FORMAT;
     }
     
-    // Write settings
-    if (fwrite(config->settings, sizeof(bios_setting_t), config->setting_count, file) != config->setting_count) {
-        fclose(file);
-        printf("Error: Cannot write settings to %s\n", filename);
-        return BIOS_ERROR_FILE;
+    uint8_t *out = buffer;
+    memcpy(out, &header, sizeof(bios_config_header_t));
+    out += sizeof(bios_config_header_t);
+    if (header.version == BIOS_VERSION_CRC32C) {
+        bios_integrity_ext_t ext = {0};
+        ext.algorithm = BIOS_INTEGRITY_CRC32C;
+        ext.crc32c = checksum_crc32c(0, settings, header.data_size);
+        memcpy(out, &ext, sizeof(bios_integrity_ext_t));
+        out += sizeof(bios_integrity_ext_t);
     }
+    memcpy(out, settings, header.data_size);
     
-    fclose(file);
-    printf("Configuration saved to %s\n", filename);
+    *image_size = size;
     return BIOS_SUCCESS;
 }
 
-// Create a new setting with specified parameters
-static void create_setting(bios_setting_t *setting, const char *name, bios_category_t category,
-                          bios_data_type_t type, uint32_t value, uint32_t min_val, uint32_t max_val) {
-    memset(setting, 0, sizeof(bios_setting_t));
-    strncpy(setting->name, name, MAX_SETTING_NAME - 1);
-    setting->category = category;
-    setting->type = type;
-    setting->min_value = min_val;
-    setting->max_value = max_val;
+int serialize_bios_config(const bios_config_t *config, uint8_t *buffer, size_t capacity, size_t *image_size) {
+    return serialize_config_image(&config->header, config->settings, config->setting_count, config->integrity,
+                                  buffer, capacity, image_size);
+}
+
+// Parse a configuration image already in memory (e.g. an archive record)
+int parse_bios_config_image(const uint8_t *image, size_t size, bios_config_t *config, bios_report_t *report) {
+    if (size < sizeof(bios_config_header_t)) {
+        report_message(report, REPORT_ERROR, "Error: Cannot read header from image");
+        return BIOS_ERROR_FORMAT;
+    }
+    memcpy(&config->header, image, sizeof(bios_config_header_t));
+    if (memcmp(config->header.signature, BIOS_SIGNATURE, 4) != 0) {
+        report_message(report, REPORT_ERROR, "Error: Invalid BIOS signature");
+        return BIOS_ERROR_FORMAT;
+    }
     
-    switch (type) {
-        case BIOS_TYPE_UINT8:
-            setting->size = 1;
-            *(uint8_t*)setting->data = (uint8_t)value;
-            break;
-        case BIOS_TYPE_UINT16:
-            setting->size = 2;
-            *(uint16_t*)setting->data = (uint16_t)value;
-            break;
-        case BIOS_TYPE_UINT32:
-            setting->size = 4;
-            *(uint32_t*)setting->data = value;
-            break;
-        case BIOS_TYPE_BOOL:
-            setting->size = 1;
-            *(uint8_t*)setting->data = value ? 1 : 0;
-            break;
-        default:
-            setting->size = 1;
-            break;
+    size_t offset = sizeof(bios_config_header_t);
+    bios_integrity_ext_t ext = {0};
+    if (config->header.version == BIOS_VERSION_CRC32C) {
+        if (size < offset + sizeof(bios_integrity_ext_t)) {
+            report_message(report, REPORT_ERROR, "Error: Cannot read integrity data from image");
+            return BIOS_ERROR_FORMAT;
+        }
+        memcpy(&ext, image + offset, sizeof(bios_integrity_ext_t));
+        offset += sizeof(bios_integrity_ext_t);
+    }
+    config->integrity = ext.algorithm;
+    
+    config->setting_count = config->header.num_settings;
+    if (config->setting_count > MAX_SETTINGS) {
+        report_message(report, REPORT_ERROR, "Error: Too many settings (%d > %d), use parse_bios_config_dyn()",
+                       config->setting_count, MAX_SETTINGS);
+        return BIOS_ERROR_FORMAT;
+    }
+    if (config->header.version == BIOS_VERSION_COMPACT) {
+        if (size < offset + config->header.data_size) {
+            report_message(report, REPORT_ERROR, "Error: Cannot read settings from image");
+            return BIOS_ERROR_FORMAT;
+        }
+        int result = expand_compact_settings(&config->header, image + offset, config->settings, MAX_SETTINGS, report);
+        if (result != BIOS_SUCCESS) {
+            return result;
+        }
+    } else {
+        if (size < offset + sizeof(bios_setting_t) * config->setting_count) {
+            report_message(report, REPORT_ERROR, "Error: Cannot read settings from image");
+            return BIOS_ERROR_FORMAT;
+        }
+        memcpy(config->settings, image + offset, sizeof(bios_setting_t) * config->setting_count);
     }
+    rebuild_setting_index(config);
+    
+    return verify_config_integrity(&config->header, &ext, config->settings, config->setting_count,
+                                   &config->checksum_stale, report);
+}
+
+// Save configuration file
+int save_bios_config(const char *filename, const bios_config_t *config) {
+    return save_bios_config_report(filename, config, NULL);
+}
+
+// Save configuration file, collecting diagnostics in report
+int save_bios_config_report(const char *filename, const bios_config_t *config, bios_report_t *report) {
+    return write_config_file(filename, &config->header, config->settings, config->setting_count, config->integrity,
+                             NULL, report);
+}
+
+// Save as part of a batch; directory flushes are deferred to commit_save_batch()
+int save_bios_config_batched(save_batch_t *batch, const char *filename, const bios_config_t *config,
+                             bios_report_t *report) {
+    return write_config_file(filename, &config->header, config->settings, config->setting_count, config->integrity,
+                             batch, report);
 }
 
 // Initialize default system configuration
 int load_default_config(bios_config_t *config) {
-    memset(config, 0, sizeof(bios_config_t));
-    
-    // Initialize header
-    memcpy(config->header.signature, BIOS_SIGNATURE, 4);
-    config->header.version = BIOS_VERSION;
-    
-    // Create default settings
-    int idx = 0;
-    
-    // CPU Settings
-    create_setting(&config->settings[idx++], "CPU_FREQ", CATEGORY_CPU, BIOS_TYPE_UINT32, 3200, 800, 5000);
-    create_setting(&config->settings[idx++], "CPU_CACHE", CATEGORY_CPU, BIOS_TYPE_BOOL, 1, 0, 1);
-    create_setting(&config->settings[idx++], "VIRTUALIZATION", CATEGORY_CPU, BIOS_TYPE_BOOL, 1, 0, 1);
-    
-    // Memory Settings
-    create_setting(&config->settings[idx++], "MEMORY_FREQ", CATEGORY_MEMORY, BIOS_TYPE_UINT32, 2400, 1333, 4000);
-    create_setting(&config->settings[idx++], "MEMORY_TEST", CATEGORY_MEMORY, BIOS_TYPE_BOOL, 0, 0, 1);
-    create_setting(&config->settings[idx++], "ECC_ENABLE", CATEGORY_MEMORY, BIOS_TYPE_BOOL, 0, 0, 1);
-    
-    // Boot Settings
-    create_setting(&config->settings[idx++], "FAST_BOOT", CATEGORY_BOOT, BIOS_TYPE_BOOL, 1, 0, 1);
-    create_setting(&config->settings[idx++], "SECURE_BOOT", CATEGORY_BOOT, BIOS_TYPE_BOOL, 1, 0, 1);
-    create_setting(&config->settings[idx++], "BOOT_TIMEOUT", CATEGORY_BOOT, BIOS_TYPE_UINT8, 5, 0, 30);
-    
-    // I/O Settings
-    create_setting(&config->settings[idx++], "USB_ENABLE", CATEGORY_IO, BIOS_TYPE_BOOL, 1, 0, 1);
-    create_setting(&config->settings[idx++], "SATA_MODE", CATEGORY_IO, BIOS_TYPE_UINT8, 1, 0, 2); // 0=IDE, 1=AHCI, 2=RAID
-    create_setting(&config->settings[idx++], "NETWORK_BOOT", CATEGORY_IO, BIOS_TYPE_BOOL, 0, 0, 1);
-    
-    config->setting_count = idx;
-    config->header.num_settings = idx;
-    config->header.data_size = sizeof(bios_setting_t) * idx;
-    config->header.checksum = calculate_checksum(config);
+    // The image, checksum included, is built at compile time; only the name index is rebuilt
+    memcpy(config, get_default_config(), sizeof(bios_config_t));
+    rebuild_setting_index(config);
+
+#ifdef BIOS_CHECKSUM_DEBUG
+    uint16_t full_checksum = calculate_checksum(config);
+    if (full_checksum != config->header.checksum) {
+        printf("Error: Default image checksum mismatch (image: %04X, full: %04X)\n",
+               config->header.checksum, full_checksum);
+        config->header.checksum = full_checksum;
+    }
+#endif
     
     printf("Default configuration initialized: %d settings\n", config->setting_count);
     return BIOS_SUCCESS;
 }
 
+// Rebuild the name index; call after adding, removing or renaming settings directly
+void rebuild_setting_index(bios_config_t *config) {
+    build_name_index(config->name_index.slots, NAME_INDEX_SLOTS, config->settings, config->setting_count);
+    config->name_index.indexed_count = config->setting_count;
+}
+
+// Find setting position by name
+int find_setting_index(const bios_config_t *config, const char *name) {
+    STATS_START(lookup_timer);
+    int idx = BIOS_ERROR_INVALID_SETTING;
+    if (config->name_index.indexed_count == config->setting_count) {
+        idx = lookup_name_index(config->name_index.slots, NAME_INDEX_SLOTS, config->settings, name);
+    } else {
+        // Index is stale (settings were filled in by hand), fall back to a scan
+        for (int i = 0; i < config->setting_count; i++) {
+            if (strncmp(config->settings[i].name, name, MAX_SETTING_NAME) == 0) {
+                idx = i;
+                break;
+            }
+        }
+    }
+    STATS_STOP(STATS_LOOKUP, lookup_timer, 0);
+    return idx;
+}
+
+// Find setting by name without copying it
+const bios_setting_t* find_setting(const bios_config_t *config, const char *name) {
+    int idx = find_setting_index(config, name);
+    return idx >= 0 ? &config->settings[idx] : NULL;
+}
+
 // Get setting by name
 int get_setting_by_name(const bios_config_t *config, const char *name, bios_setting_t *setting) {
-    for (int i = 0; i < config->setting_count; i++) {
-        if (strcmp(config->settings[i].name, name) == 0) {
-            *setting = config->settings[i];
-            return BIOS_SUCCESS;
-        }
+    int idx = find_setting_index(config, name);
+    if (idx < 0) {
+        return BIOS_ERROR_INVALID_SETTING;
     }
-    return BIOS_ERROR_INVALID_SETTING;
+    *setting = config->settings[idx];
+    return BIOS_SUCCESS;
 }
 
 // Set setting by name
 int set_setting_by_name(bios_config_t *config, const char *name, const void *value) {
-    for (int i = 0; i < config->setting_count; i++) {
-        if (strcmp(config->settings[i].name, name) == 0) {
-            memcpy(config->settings[i].data, value, config->settings[i].size);
-            config->header.checksum = calculate_checksum(config);
-            // Recalculate checksum
+    int idx = find_setting_index(config, name);
+    if (idx < 0) {
+        return BIOS_ERROR_INVALID_SETTING;
+    }
+    bios_setting_t *setting = &config->settings[idx];
+    if (config->checksum_stale) {
+        // Stored checksum never matched, start over from a full recompute
+        memcpy(setting->data, value, setting->size);
+        config->header.checksum = calculate_checksum(config);
+        config->checksum_stale = 0;
+    } else {
+        // Only this setting's data bytes change
+        config->header.checksum = update_checksum_bytes(config->header.checksum, setting->data, value, setting->size);
+        memcpy(setting->data, value, setting->size);
+    }
+    
+#ifdef BIOS_CHECKSUM_DEBUG
+    uint16_t full_checksum = calculate_checksum(config);
+    if (full_checksum != config->header.checksum) {
+        printf("Error: Incremental checksum drift on %s (incremental: %04X, full: %04X)\n",
+               name, config->header.checksum, full_checksum);
+        config->header.checksum = full_checksum;
+    }
+#endif
+    return BIOS_SUCCESS;
+}
+
+// Utility functions
+// Numeric value of a setting, widened to 32 bits (strings read as 0)
+uint32_t get_setting_value(const bios_setting_t *setting) {
+    switch (setting->type) {
+        case BIOS_TYPE_UINT8:
+        case BIOS_TYPE_BOOL:
+            return *(uint8_t*)setting->data;
+        case BIOS_TYPE_UINT16:
+            return *(uint16_t*)setting->data;
+        case BIOS_TYPE_UINT32:
+            return *(uint32_t*)setting->data;
+        default:
+            return 0;
+    }
+}
+
+// Store value in the setting's own width; fails if it does not fit
+int encode_setting_value(const bios_setting_t *setting, uint32_t value, uint8_t data[MAX_SETTING_DATA]) {
+    memset(data, 0, MAX_SETTING_DATA);
+    switch (setting->type) {
+        case BIOS_TYPE_UINT8:
+        case BIOS_TYPE_BOOL:
+            if (value > 0xFF) {
+                return BIOS_ERROR_INVALID_SETTING;
+            }
+            data[0] = (uint8_t)value;
+            return BIOS_SUCCESS;
+        case BIOS_TYPE_UINT16: {
+            if (value > 0xFFFF) {
+                return BIOS_ERROR_INVALID_SETTING;
+            }
+            uint16_t narrow = (uint16_t)value;
+            memcpy(data, &narrow, sizeof(narrow));
             return BIOS_SUCCESS;
         }
+        case BIOS_TYPE_UINT32:
+            memcpy(data, &value, sizeof(value));
+            return BIOS_SUCCESS;
+        default:
+            return BIOS_ERROR_INVALID_SETTING;
     }
-    return BIOS_ERROR_INVALID_SETTING;
 }
 
-// Utility functions
+// Convert text to a value of the setting's type (booleans also accept on/off, true/false, enabled/disabled)
+int parse_setting_text(const bios_setting_t *setting, const char *text, uint32_t *value) {
+    if (setting->type == BIOS_TYPE_BOOL) {
+        if (strcmp(text, "1") == 0 || strcmp(text, "on") == 0 || strcmp(text, "true") == 0 ||
+            strcmp(text, "enabled") == 0) {
+            *value = 1;
+            return BIOS_SUCCESS;
+        }
+        if (strcmp(text, "0") == 0 || strcmp(text, "off") == 0 || strcmp(text, "false") == 0 ||
+            strcmp(text, "disabled") == 0) {
+            *value = 0;
+            return BIOS_SUCCESS;
+        }
+        return BIOS_ERROR_INVALID_SETTING;
+    }
+
+    char *end;
+    unsigned long parsed = strtoul(text, &end, 0);
+    if (end == text || *end != '\0' || text[0] == '-' || parsed > 0xFFFFFFFFUL) {
+        return BIOS_ERROR_INVALID_SETTING;
+    }
+    *value = (uint32_t)parsed;
+    return BIOS_SUCCESS;
+}
+
 const char* get_category_name(bios_category_t category) {
     switch (category) {
         case CATEGORY_CPU: return "CPU";
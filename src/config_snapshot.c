@@ -0,0 +1,161 @@
+#include "../include/config_snapshot.h"
+#include "../include/config_parser.h"
+
+// Epoch 0 means "not reading", so the global epoch starts at 1
+#define FIRST_EPOCH 1
+
+int init_config_snapshot(config_snapshot_t *snapshot, const bios_config_t *initial) {
+    memset(snapshot, 0, sizeof(config_snapshot_t));
+    config_version_t *version = calloc(1, sizeof(config_version_t));
+    if (!version) {
+        printf("Error: Cannot allocate configuration snapshot\n");
+        return BIOS_ERROR_FILE;
+    }
+    version->config = *initial;
+    version->version = 1;
+
+    atomic_init(&snapshot->current, version);
+    atomic_init(&snapshot->epoch, FIRST_EPOCH);
+    atomic_init(&snapshot->readers, NULL);
+    return BIOS_SUCCESS;
+}
+
+void destroy_config_snapshot(config_snapshot_t *snapshot) {
+    abort_snapshot_edit(snapshot);
+    free(atomic_load(&snapshot->current));
+    atomic_store(&snapshot->current, NULL);
+
+    while (snapshot->retired) {
+        config_version_t *next = snapshot->retired->next_retired;
+        free(snapshot->retired);
+        snapshot->retired = next;
+    }
+    snapshot->retired_count = 0;
+
+    snapshot_reader_t *reader = atomic_load(&snapshot->readers);
+    while (reader) {
+        snapshot_reader_t *next = reader->next;
+        free(reader);
+        reader = next;
+    }
+    atomic_store(&snapshot->readers, NULL);
+}
+
+// Reuse a released slot if there is one, otherwise add a new one
+snapshot_reader_t* register_snapshot_reader(config_snapshot_t *snapshot) {
+    for (snapshot_reader_t *reader = atomic_load(&snapshot->readers); reader; reader = reader->next) {
+        int expected = 0;
+        if (atomic_load_explicit(&reader->in_use, memory_order_relaxed) == 0 &&
+            atomic_compare_exchange_strong(&reader->in_use, &expected, 1)) {
+            return reader;
+        }
+    }
+
+    snapshot_reader_t *reader = calloc(1, sizeof(snapshot_reader_t));
+    if (!reader) {
+        return NULL;
+    }
+    atomic_init(&reader->epoch, 0);
+    atomic_init(&reader->in_use, 1);
+
+    snapshot_reader_t *head = atomic_load(&snapshot->readers);
+    do {
+        reader->next = head;
+    } while (!atomic_compare_exchange_weak(&snapshot->readers, &head, reader));
+    return reader;
+}
+
+void unregister_snapshot_reader(snapshot_reader_t *reader) {
+    atomic_store(&reader->epoch, 0);
+    atomic_store(&reader->in_use, 0);
+}
+
+// Announce the epoch before loading the version: a writer that misses the
+// announcement has already swapped, so this reader gets the new version
+const bios_config_t* read_snapshot_begin(config_snapshot_t *snapshot, snapshot_reader_t *reader) {
+    atomic_store(&reader->epoch, atomic_load(&snapshot->epoch));
+    return &atomic_load(&snapshot->current)->config;
+}
+
+void read_snapshot_end(snapshot_reader_t *reader) {
+    atomic_store_explicit(&reader->epoch, 0, memory_order_release);
+}
+
+uint64_t get_snapshot_version(const bios_config_t *config) {
+    return ((const config_version_t*)config)->version;
+}
+
+// Private copy of the current version for the writer to change
+bios_config_t* begin_snapshot_edit(config_snapshot_t *snapshot) {
+    if (!snapshot->edit) {
+        snapshot->edit = malloc(sizeof(config_version_t));
+        if (!snapshot->edit) {
+            printf("Error: Cannot allocate configuration snapshot\n");
+            return NULL;
+        }
+        config_version_t *current = atomic_load_explicit(&snapshot->current, memory_order_relaxed);
+        *snapshot->edit = *current;
+        snapshot->edit->version = current->version + 1;
+        snapshot->edit->next_retired = NULL;
+    }
+    return &snapshot->edit->config;
+}
+
+int publish_snapshot_edit(config_snapshot_t *snapshot) {
+    config_version_t *edit = snapshot->edit;
+    if (!edit) {
+        return BIOS_ERROR_INVALID_SETTING;
+    }
+    snapshot->edit = NULL;
+
+    // Readers that can still hold the old version announced an epoch no later than this one
+    config_version_t *old = atomic_exchange(&snapshot->current, edit);
+    old->retire_epoch = atomic_fetch_add(&snapshot->epoch, 1);
+    old->next_retired = snapshot->retired;
+    snapshot->retired = old;
+    snapshot->retired_count++;
+
+    reclaim_snapshots(snapshot);
+    return BIOS_SUCCESS;
+}
+
+void abort_snapshot_edit(config_snapshot_t *snapshot) {
+    free(snapshot->edit);
+    snapshot->edit = NULL;
+}
+
+int snapshot_set_setting(config_snapshot_t *snapshot, const char *name, const void *value) {
+    bios_config_t *config = begin_snapshot_edit(snapshot);
+    if (!config) {
+        return BIOS_ERROR_FILE;
+    }
+    int result = set_setting_by_name(config, name, value);
+    if (result != BIOS_SUCCESS) {
+        abort_snapshot_edit(snapshot);
+        return result;
+    }
+    return publish_snapshot_edit(snapshot);
+}
+
+// Free retired versions older than every active reader's epoch
+void reclaim_snapshots(config_snapshot_t *snapshot) {
+    uint64_t oldest_active = UINT64_MAX;
+    for (snapshot_reader_t *reader = atomic_load(&snapshot->readers); reader; reader = reader->next) {
+        uint64_t epoch = atomic_load(&reader->epoch);
+        if (epoch != 0 && epoch < oldest_active) {
+            oldest_active = epoch;
+        }
+    }
+
+    config_version_t **link = &snapshot->retired;
+    while (*link) {
+        config_version_t *version = *link;
+        if (version->retire_epoch < oldest_active) {
+            *link = version->next_retired;
+            free(version);
+            snapshot->retired_count--;
+        } else {
+            link = &version->next_retired;
+        }
+    }
+}
\ No newline at end of file
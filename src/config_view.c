@@ -0,0 +1,161 @@
+#include "../include/config_view.h"
+#include "../include/config_parser.h"
+#include "../include/checksum.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Map the whole file read-only
+static int map_config_file(const char *filename, bios_config_view_t *view) {
+#ifdef _WIN32
+    view->file_handle = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL,
+                                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (view->file_handle == INVALID_HANDLE_VALUE) {
+        return BIOS_ERROR_FILE;
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(view->file_handle, &file_size) ||
+        file_size.QuadPart < (LONGLONG)sizeof(bios_config_header_t)) {
+        CloseHandle(view->file_handle);
+        return BIOS_ERROR_FORMAT;
+    }
+    view->map_size = (size_t)file_size.QuadPart;
+
+    view->mapping_handle = CreateFileMappingA(view->file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!view->mapping_handle) {
+        CloseHandle(view->file_handle);
+        return BIOS_ERROR_FILE;
+    }
+
+    view->map_base = MapViewOfFile(view->mapping_handle, FILE_MAP_READ, 0, 0, 0);
+    if (!view->map_base) {
+        CloseHandle(view->mapping_handle);
+        CloseHandle(view->file_handle);
+        return BIOS_ERROR_FILE;
+    }
+#else
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        return BIOS_ERROR_FILE;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(bios_config_header_t)) {
+        close(fd);
+        return BIOS_ERROR_FORMAT;
+    }
+    view->map_size = (size_t)st.st_size;
+
+    void *base = mmap(NULL, view->map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // The mapping keeps its own reference
+    if (base == MAP_FAILED) {
+        return BIOS_ERROR_FILE;
+    }
+    view->map_base = base;
+#endif
+    return BIOS_SUCCESS;
+}
+
+static void unmap_config_file(bios_config_view_t *view) {
+#ifdef _WIN32
+    UnmapViewOfFile(view->map_base);
+    CloseHandle(view->mapping_handle);
+    CloseHandle(view->file_handle);
+#else
+    munmap((void*)view->map_base, view->map_size);
+#endif
+}
+
+// Open a read-only view of a configuration file
+int open_bios_config_view(const char *filename, bios_config_view_t *view) {
+    memset(view, 0, sizeof(bios_config_view_t));
+
+    int result = map_config_file(filename, view);
+    if (result == BIOS_ERROR_FILE) {
+        printf("Error: Cannot map file %s\n", filename);
+        return result;
+    }
+    if (result != BIOS_SUCCESS) {
+        printf("Error: Cannot read header from %s\n", filename);
+        return result;
+    }
+
+    view->header = (const bios_config_header_t*)view->map_base;
+
+    // Validate signature
+    if (memcmp(view->header->signature, BIOS_SIGNATURE, 4) != 0) {
+        printf("Error: Invalid BIOS signature\n");
+        close_bios_config_view(view);
+        return BIOS_ERROR_FORMAT;
+    }
+
+    // Compact files have no in-place settings to map
+    if (view->header->version == BIOS_VERSION_COMPACT) {
+        printf("Error: %s is a compact file, use parse_bios_config()\n", filename);
+        close_bios_config_view(view);
+        return BIOS_ERROR_FORMAT;
+    }
+
+    // Version 2 files carry an integrity extension before the settings
+    size_t settings_offset = sizeof(bios_config_header_t);
+    if (view->header->version == BIOS_VERSION_CRC32C) {
+        view->integrity = (const bios_integrity_ext_t*)((const uint8_t*)view->map_base + settings_offset);
+        settings_offset += sizeof(bios_integrity_ext_t);
+    }
+
+    // Settings must lie entirely inside the mapping
+    view->setting_count = view->header->num_settings;
+    size_t needed = settings_offset + sizeof(bios_setting_t) * (size_t)view->setting_count;
+    if (view->map_size < needed) {
+        printf("Error: Cannot read settings from %s\n", filename);
+        close_bios_config_view(view);
+        return BIOS_ERROR_FORMAT;
+    }
+
+    view->settings = (const bios_setting_t*)((const uint8_t*)view->map_base + settings_offset);
+    return BIOS_SUCCESS;
+}
+
+// Release the mapping
+void close_bios_config_view(bios_config_view_t *view) {
+    if (view->map_base) {
+        unmap_config_file(view);
+    }
+    memset(view, 0, sizeof(bios_config_view_t));
+}
+
+// Get setting by position, without copying
+const bios_setting_t* view_get_setting(const bios_config_view_t *view, int index) {
+    if (index < 0 || index >= view->setting_count) {
+        return NULL;
+    }
+    return &view->settings[index];
+}
+
+// Get setting by name, without copying
+const bios_setting_t* view_find_setting(const bios_config_view_t *view, const char *name) {
+    for (int i = 0; i < view->setting_count; i++) {
+        if (strncmp(view->settings[i].name, name, MAX_SETTING_NAME) == 0) {
+            return &view->settings[i];
+        }
+    }
+    return NULL;
+}
+
+// Verify the stored checksum (and CRC32C, if present) directly over the mapped settings
+int verify_view_checksum(const bios_config_view_t *view) {
+    size_t size = sizeof(bios_setting_t) * (size_t)view->setting_count;
+    if (calculate_checksum_bytes(view->settings, size) != view->header->checksum) {
+        return BIOS_ERROR_CHECKSUM;
+    }
+    if (view->integrity && view->integrity->algorithm == BIOS_INTEGRITY_CRC32C &&
+        checksum_crc32c(0, view->settings, size) != view->integrity->crc32c) {
+        return BIOS_ERROR_CHECKSUM;
+    }
+    return BIOS_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,257 @@
+#include "../include/daemon_client.h"
+
+#ifndef _WIN32
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static int send_all(int fd, const uint8_t *data, size_t size) {
+    while (size > 0) {
+        ssize_t sent = send(fd, data, size, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return BIOS_ERROR_FILE;
+        }
+        data += sent;
+        size -= (size_t)sent;
+    }
+    return BIOS_SUCCESS;
+}
+
+static int receive_all(int fd, uint8_t *data, size_t size) {
+    while (size > 0) {
+        ssize_t received = recv(fd, data, size, 0);
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            return BIOS_ERROR_FILE;
+        }
+        data += received;
+        size -= (size_t)received;
+    }
+    return BIOS_SUCCESS;
+}
+
+int connect_config_daemon(daemon_client_t *client, const char *socket_path) {
+    memset(client, 0, sizeof(daemon_client_t));
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(socket_path) >= sizeof(address.sun_path)) {
+        snprintf(client->last_error, sizeof(client->last_error), "Error: Socket path too long");
+        client->fd = -1;
+        return BIOS_ERROR_FILE;
+    }
+    strcpy(address.sun_path, socket_path);
+
+    client->fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (client->fd < 0 || connect(client->fd, (struct sockaddr*)&address, sizeof(address)) != 0) {
+        snprintf(client->last_error, sizeof(client->last_error), "Error: Cannot connect to %s", socket_path);
+        disconnect_config_daemon(client);
+        return BIOS_ERROR_FILE;
+    }
+    return BIOS_SUCCESS;
+}
+
+void disconnect_config_daemon(daemon_client_t *client) {
+    if (client->fd >= 0) {
+        close(client->fd);
+    }
+    client->fd = -1;
+}
+
+// Send the request in client->buffer (payload already in place), wait for the response.
+// The response payload replaces the request payload; its length goes to *response_length.
+static int daemon_request(daemon_client_t *client, uint8_t opcode, uint32_t request_length, uint32_t *response_length) {
+    daemon_frame_t frame;
+    frame.length = request_length;
+    frame.opcode = opcode;
+    frame.reserved = 0;
+    frame.status = 0;
+    memcpy(client->buffer, &frame, sizeof(frame));
+
+    if (client->fd < 0 ||
+        send_all(client->fd, client->buffer, sizeof(frame) + request_length) != BIOS_SUCCESS ||
+        receive_all(client->fd, (uint8_t*)&frame, sizeof(frame)) != BIOS_SUCCESS ||
+        frame.length > DAEMON_MAX_PAYLOAD || frame.opcode != opcode ||
+        receive_all(client->fd, client->buffer + sizeof(frame), frame.length) != BIOS_SUCCESS) {
+        snprintf(client->last_error, sizeof(client->last_error), "Error: Lost connection to the daemon");
+        disconnect_config_daemon(client);
+        return BIOS_ERROR_FILE;
+    }
+
+    *response_length = frame.length;
+    if (frame.status != BIOS_SUCCESS && frame.length > 0) {
+        snprintf(client->last_error, sizeof(client->last_error), "%.*s",
+                 (int)frame.length, (const char*)client->buffer + sizeof(frame));
+    }
+    return frame.status;
+}
+
+// Request payload builder over client->buffer
+static uint8_t* request_payload(daemon_client_t *client) {
+    return client->buffer + sizeof(daemon_frame_t);
+}
+
+static uint32_t put_text(uint8_t *payload, uint32_t offset, const char *text) {
+    size_t length = strlen(text);
+    if (offset + length > DAEMON_MAX_PAYLOAD) {
+        length = DAEMON_MAX_PAYLOAD - offset;
+    }
+    memcpy(payload + offset, text, length);
+    return offset + (uint32_t)length;
+}
+
+int daemon_open_config(daemon_client_t *client, const char *path, uint32_t *handle) {
+    uint8_t *payload = request_payload(client);
+    uint32_t length;
+    int result = daemon_request(client, DAEMON_OP_OPEN, put_text(payload, 0, path), &length);
+    if (result == BIOS_SUCCESS) {
+        memcpy(handle, payload, sizeof(uint32_t));
+    }
+    return result;
+}
+
+int daemon_get_setting(daemon_client_t *client, uint32_t handle, const char *name, uint32_t *value) {
+    uint8_t *payload = request_payload(client);
+    uint32_t length;
+    memcpy(payload, &handle, sizeof(handle));
+    int result = daemon_request(client, DAEMON_OP_GET, put_text(payload, sizeof(handle), name), &length);
+    if (result == BIOS_SUCCESS) {
+        memcpy(value, payload, sizeof(uint32_t));
+    }
+    return result;
+}
+
+int daemon_set_setting(daemon_client_t *client, uint32_t handle, const char *name, uint32_t value) {
+    uint8_t *payload = request_payload(client);
+    uint32_t length;
+    memcpy(payload, &handle, sizeof(handle));
+    memcpy(payload + sizeof(handle), &value, sizeof(value));
+    return daemon_request(client, DAEMON_OP_SET, put_text(payload, sizeof(handle) + sizeof(value), name), &length);
+}
+
+// Validation messages are added to report (NULL prints them), as a local validate would
+int daemon_validate_config(daemon_client_t *client, uint32_t handle, bios_report_t *report) {
+    uint8_t *payload = request_payload(client);
+    uint32_t length;
+    memcpy(payload, &handle, sizeof(handle));
+    int result = daemon_request(client, DAEMON_OP_VALIDATE, sizeof(handle), &length);
+    if (result == BIOS_ERROR_FILE || length < 2 * sizeof(uint16_t)) {
+        return result;
+    }
+
+    uint16_t errors, warnings;
+    memcpy(&errors, payload, sizeof(errors));
+    memcpy(&warnings, payload + sizeof(errors), sizeof(warnings));
+    const char *message = (const char*)payload + 2 * sizeof(uint16_t);
+    const char *end = (const char*)payload + length;
+    int replayed_errors = 0;
+    int replayed_warnings = 0;
+    while (message < end) {
+        const char *newline = memchr(message, '\n', (size_t)(end - message));
+        int message_length = (int)((newline ? newline : end) - message);
+        int is_error = strncmp(message, "Error", 5) == 0;
+        report_message(report, is_error ? REPORT_ERROR : REPORT_WARNING, "%.*s", message_length, message);
+        replayed_errors += is_error;
+        replayed_warnings += !is_error;
+        message += message_length + 1;
+    }
+
+    // Counts include messages the daemon's report had no room for
+    if (report) {
+        report->error_count += errors - replayed_errors;
+        report->warning_count += warnings - replayed_warnings;
+    }
+    return result;
+}
+
+int daemon_diff_configs(daemon_client_t *client, uint32_t first, uint32_t second,
+                        daemon_diff_entry_t *entries, int capacity, int *count) {
+    uint8_t *payload = request_payload(client);
+    uint32_t length;
+    memcpy(payload, &first, sizeof(first));
+    memcpy(payload + sizeof(first), &second, sizeof(second));
+    *count = 0;
+    int result = daemon_request(client, DAEMON_OP_DIFF, sizeof(first) + sizeof(second), &length);
+    if (result != BIOS_SUCCESS) {
+        return result;
+    }
+
+    uint16_t total;
+    memcpy(&total, payload, sizeof(total));
+    uint32_t offset = sizeof(total);
+    for (int i = 0; i < total && i < capacity; i++) {
+        daemon_diff_entry_t *entry = &entries[i];
+        uint8_t name_length = payload[offset++];
+        memset(entry->name, 0, sizeof(entry->name));
+        memcpy(entry->name, payload + offset, name_length < MAX_SETTING_NAME ? name_length : MAX_SETTING_NAME - 1);
+        offset += name_length;
+        entry->presence = payload[offset++];
+        memcpy(&entry->first_value, payload + offset, sizeof(uint32_t));
+        memcpy(&entry->second_value, payload + offset + sizeof(uint32_t), sizeof(uint32_t));
+        offset += 2 * sizeof(uint32_t);
+        (*count)++;
+    }
+    return total > capacity ? BIOS_ERROR_FORMAT : BIOS_SUCCESS;
+}
+
+int daemon_save_config(daemon_client_t *client, uint32_t handle, const char *path) {
+    uint8_t *payload = request_payload(client);
+    uint32_t length;
+    memcpy(payload, &handle, sizeof(handle));
+    uint32_t request_length = path ? put_text(payload, sizeof(handle), path) : sizeof(handle);
+    return daemon_request(client, DAEMON_OP_SAVE, request_length, &length);
+}
+
+#else
+
+int connect_config_daemon(daemon_client_t *client, const char *socket_path) {
+    (void)socket_path;
+    memset(client, 0, sizeof(daemon_client_t));
+    client->fd = -1;
+    snprintf(client->last_error, sizeof(client->last_error), "Error: The config daemon needs Unix sockets");
+    return BIOS_ERROR_FILE;
+}
+
+void disconnect_config_daemon(daemon_client_t *client) {
+    client->fd = -1;
+}
+
+int daemon_open_config(daemon_client_t *client, const char *path, uint32_t *handle) {
+    (void)client; (void)path; (void)handle;
+    return BIOS_ERROR_FILE;
+}
+
+int daemon_get_setting(daemon_client_t *client, uint32_t handle, const char *name, uint32_t *value) {
+    (void)client; (void)handle; (void)name; (void)value;
+    return BIOS_ERROR_FILE;
+}
+
+int daemon_set_setting(daemon_client_t *client, uint32_t handle, const char *name, uint32_t value) {
+    (void)client; (void)handle; (void)name; (void)value;
+    return BIOS_ERROR_FILE;
+}
+
+int daemon_validate_config(daemon_client_t *client, uint32_t handle, bios_report_t *report) {
+    (void)client; (void)handle; (void)report;
+    return BIOS_ERROR_FILE;
+}
+
+int daemon_diff_configs(daemon_client_t *client, uint32_t first, uint32_t second,
+                        daemon_diff_entry_t *entries, int capacity, int *count) {
+    (void)client; (void)first; (void)second; (void)entries; (void)capacity;
+    *count = 0;
+    return BIOS_ERROR_FILE;
+}
+
+int daemon_save_config(daemon_client_t *client, uint32_t handle, const char *path) {
+    (void)client; (void)handle; (void)path;
+    return BIOS_ERROR_FILE;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include "../include/default_config.h"
+
+// Value bytes as stored in a setting (little-endian, in the type's own width)
+#define DEFAULT_TYPE_SIZE(type) ((type) == BIOS_TYPE_UINT32 ? 4 : (type) == BIOS_TYPE_UINT16 ? 2 : 1)
+#define DEFAULT_STORED(type, value) ((type) == BIOS_TYPE_BOOL ? ((value) ? 1u : 0u) : (uint32_t)(value))
+#define DEFAULT_BYTE(value, n) ((uint8_t)(((uint32_t)(value) >> (8 * (n))) & 0xFF))
+#define DEFAULT_BYTE_SUM(value) \
+    (DEFAULT_BYTE(value, 0) + DEFAULT_BYTE(value, 1) + DEFAULT_BYTE(value, 2) + DEFAULT_BYTE(value, 3))
+
+// Sum of the name field's bytes; the literal's own NUL and the zero padding add nothing
+#define DEFAULT_NAME_BYTE(name, i) (sizeof(name) > (i) ? (uint8_t)(name)[i] : 0)
+#define DEFAULT_NAME_SUM_8(name, i) \
+    (DEFAULT_NAME_BYTE(name, i) + DEFAULT_NAME_BYTE(name, i + 1) + DEFAULT_NAME_BYTE(name, i + 2) + \
+     DEFAULT_NAME_BYTE(name, i + 3) + DEFAULT_NAME_BYTE(name, i + 4) + DEFAULT_NAME_BYTE(name, i + 5) + \
+     DEFAULT_NAME_BYTE(name, i + 6) + DEFAULT_NAME_BYTE(name, i + 7))
+#define DEFAULT_NAME_SUM(name) \
+    (DEFAULT_NAME_SUM_8(name, 0) + DEFAULT_NAME_SUM_8(name, 8) + DEFAULT_NAME_SUM_8(name, 16) + \
+     DEFAULT_NAME_SUM_8(name, 24))
+
+// Every byte of one bios_setting_t, as calculate_checksum() adds them (flags are 0)
+#define DEFAULT_SETTING_SUM(name, category, type, value, min_value, max_value) \
+    (DEFAULT_NAME_SUM(name) + (category) + (type) + DEFAULT_TYPE_SIZE(type) + \
+     DEFAULT_BYTE_SUM(DEFAULT_STORED(type, value)) + DEFAULT_BYTE_SUM(min_value) + DEFAULT_BYTE_SUM(max_value))
+
+enum {
+    DEFAULT_SETTING_COUNT = 0
+#define SCHEMA_SETTING(id, since, name, category, type, default_value, min_value, max_value) + 1
+#include "../include/schema_settings.def"
+#undef SCHEMA_SETTING
+};
+
+_Static_assert(DEFAULT_SETTING_COUNT <= MAX_SETTINGS, "too many settings in schema_settings.def");
+
+// Names keep a terminating NUL inside the name field
+#define SCHEMA_SETTING(id, since, name, category, type, default_value, min_value, max_value) \
+    _Static_assert(sizeof(name) <= MAX_SETTING_NAME, "setting name too long: " name);
+#include "../include/schema_settings.def"
+#undef SCHEMA_SETTING
+
+static const bios_config_t default_config = {
+    .header = {
+        .signature = BIOS_SIGNATURE,
+        .version = BIOS_VERSION,
+        .num_settings = DEFAULT_SETTING_COUNT,
+        .data_size = sizeof(bios_setting_t) * DEFAULT_SETTING_COUNT,
+        .checksum = (uint16_t)(0
+#define SCHEMA_SETTING(id, since, name, category, type, default_value, min_value, max_value) \
+            + DEFAULT_SETTING_SUM(name, category, type, default_value, min_value, max_value)
+#include "../include/schema_settings.def"
+#undef SCHEMA_SETTING
+        ),
+        .reserved = 0
+    },
+    .settings = {
+#define SCHEMA_SETTING(id, since, setting_name, setting_category, setting_type, default_value, minimum, maximum) \
+        { \
+            .name = setting_name, \
+            .category = setting_category, \
+            .type = setting_type, \
+            .size = DEFAULT_TYPE_SIZE(setting_type), \
+            .data = { DEFAULT_BYTE(DEFAULT_STORED(setting_type, default_value), 0), \
+                      DEFAULT_BYTE(DEFAULT_STORED(setting_type, default_value), 1), \
+                      DEFAULT_BYTE(DEFAULT_STORED(setting_type, default_value), 2), \
+                      DEFAULT_BYTE(DEFAULT_STORED(setting_type, default_value), 3) }, \
+            .min_value = minimum, \
+            .max_value = maximum \
+        },
+#include "../include/schema_settings.def"
+#undef SCHEMA_SETTING
+    },
+    .setting_count = DEFAULT_SETTING_COUNT
+};
+
+const bios_config_t* get_default_config(void) {
+    return &default_config;
+}
\ No newline at end of file
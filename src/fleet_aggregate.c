@@ -0,0 +1,504 @@
+#include "../include/fleet_aggregate.h"
+#include "../include/config_parser.h"
+#include "../include/thread_pool.h"
+
+#define VALUE_COUNTS_INITIAL_SLOTS 16
+
+typedef struct {
+    uint32_t value;
+    uint64_t count;
+} value_count_t;
+
+// Value counts
+
+static void init_value_counts(value_counts_t *counts) {
+    memset(counts, 0, sizeof(value_counts_t));
+}
+
+static void free_value_counts(value_counts_t *counts) {
+    free(counts->values);
+    free(counts->counts);
+    init_value_counts(counts);
+}
+
+static size_t value_slot(uint32_t value, size_t slot_count) {
+    return (size_t)((value * 2654435761u) & (uint32_t)(slot_count - 1));
+}
+
+static int grow_value_counts(value_counts_t *counts) {
+    size_t slot_count = counts->slot_count ? counts->slot_count * 2 : VALUE_COUNTS_INITIAL_SLOTS;
+    uint32_t *values = malloc(sizeof(uint32_t) * slot_count);
+    uint64_t *slot_counts = calloc(slot_count, sizeof(uint64_t));
+    if (!values || !slot_counts) {
+        free(values);
+        free(slot_counts);
+        return BIOS_ERROR_FILE;
+    }
+
+    for (size_t i = 0; i < counts->slot_count; i++) {
+        if (counts->counts[i]) {
+            size_t slot = value_slot(counts->values[i], slot_count);
+            while (slot_counts[slot]) {
+                slot = (slot + 1) & (slot_count - 1);
+            }
+            values[slot] = counts->values[i];
+            slot_counts[slot] = counts->counts[i];
+        }
+    }
+
+    free(counts->values);
+    free(counts->counts);
+    counts->values = values;
+    counts->counts = slot_counts;
+    counts->slot_count = slot_count;
+    return BIOS_SUCCESS;
+}
+
+static int add_value_count(value_counts_t *counts, uint32_t value, uint64_t count) {
+    // Keep at most 70% of the slots in use
+    if ((counts->used + 1) * 10 > counts->slot_count * 7 && grow_value_counts(counts) != BIOS_SUCCESS) {
+        return BIOS_ERROR_FILE;
+    }
+
+    size_t slot = value_slot(value, counts->slot_count);
+    while (counts->counts[slot] && counts->values[slot] != value) {
+        slot = (slot + 1) & (counts->slot_count - 1);
+    }
+    if (!counts->counts[slot]) {
+        counts->values[slot] = value;
+        counts->used++;
+    }
+    counts->counts[slot] += count;
+    return BIOS_SUCCESS;
+}
+
+static int compare_value_counts(const void *a, const void *b) {
+    uint32_t left = ((const value_count_t*)a)->value;
+    uint32_t right = ((const value_count_t*)b)->value;
+    return (left > right) - (left < right);
+}
+
+// Distinct values in ascending order; the caller frees the result
+static value_count_t* sort_value_counts(const value_counts_t *counts) {
+    value_count_t *sorted = malloc(sizeof(value_count_t) * (counts->used ? counts->used : 1));
+    if (!sorted) {
+        return NULL;
+    }
+    size_t used = 0;
+    for (size_t i = 0; i < counts->slot_count; i++) {
+        if (counts->counts[i]) {
+            sorted[used].value = counts->values[i];
+            sorted[used].count = counts->counts[i];
+            used++;
+        }
+    }
+    qsort(sorted, used, sizeof(value_count_t), compare_value_counts);
+    return sorted;
+}
+
+// Nearest-rank percentile over sorted value counts
+static uint32_t sorted_percentile(const value_count_t *sorted, size_t used, uint64_t total, double percentile) {
+    if (!used) {
+        return 0;
+    }
+    double target = percentile / 100.0 * (double)total;
+    uint64_t rank = (uint64_t)target;
+    if ((double)rank < target || rank == 0) {
+        rank++;
+    }
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < used; i++) {
+        seen += sorted[i].count;
+        if (seen >= rank) {
+            return sorted[i].value;
+        }
+    }
+    return sorted[used - 1].value;
+}
+
+// Aggregates
+
+void init_aggregate(aggregate_t *aggregate, const char *setting, const char *group_by, uint32_t group_width) {
+    memset(aggregate, 0, sizeof(aggregate_t));
+    snprintf(aggregate->setting, sizeof(aggregate->setting), "%s", setting);
+    if (group_by) {
+        snprintf(aggregate->group_by, sizeof(aggregate->group_by), "%s", group_by);
+    }
+    aggregate->group_width = group_width ? group_width : 1;
+}
+
+int parse_aggregate_spec(const char *spec, aggregate_t *aggregate) {
+    char setting[MAX_SETTING_NAME];
+    char group_by[MAX_SETTING_NAME] = "";
+    uint32_t group_width = 1;
+
+    const char *colon = strchr(spec, ':');
+    size_t setting_length = colon ? (size_t)(colon - spec) : strlen(spec);
+    if (setting_length == 0 || setting_length >= MAX_SETTING_NAME) {
+        printf("Error: Invalid aggregate '%s'\n", spec);
+        return BIOS_ERROR_INVALID_SETTING;
+    }
+    memcpy(setting, spec, setting_length);
+    setting[setting_length] = '\0';
+
+    if (colon) {
+        const char *slash = strchr(colon + 1, '/');
+        size_t group_length = slash ? (size_t)(slash - colon - 1) : strlen(colon + 1);
+        char *end = NULL;
+        if (slash) {
+            unsigned long width = strtoul(slash + 1, &end, 10);
+            group_width = (uint32_t)width;
+        }
+        if (group_length == 0 || group_length >= MAX_SETTING_NAME || (slash && (*end || group_width == 0))) {
+            printf("Error: Invalid aggregate '%s'\n", spec);
+            return BIOS_ERROR_INVALID_SETTING;
+        }
+        memcpy(group_by, colon + 1, group_length);
+        group_by[group_length] = '\0';
+    }
+
+    init_aggregate(aggregate, setting, colon ? group_by : NULL, group_width);
+    return BIOS_SUCCESS;
+}
+
+void free_aggregate(aggregate_t *aggregate) {
+    for (int i = 0; i < aggregate->group_count; i++) {
+        free_value_counts(&aggregate->groups[i].values);
+    }
+    free(aggregate->groups);
+    aggregate->groups = NULL;
+    aggregate->group_count = aggregate->group_capacity = 0;
+}
+
+static aggregate_group_t* find_group(aggregate_t *aggregate, uint32_t group) {
+    for (int i = 0; i < aggregate->group_count; i++) {
+        if (aggregate->groups[i].group == group) {
+            return &aggregate->groups[i];
+        }
+    }
+
+    if (aggregate->group_count == aggregate->group_capacity) {
+        int capacity = aggregate->group_capacity ? aggregate->group_capacity * 2 : 8;
+        aggregate_group_t *groups = realloc(aggregate->groups, sizeof(aggregate_group_t) * capacity);
+        if (!groups) {
+            return NULL;
+        }
+        aggregate->groups = groups;
+        aggregate->group_capacity = capacity;
+    }
+    aggregate_group_t *created = &aggregate->groups[aggregate->group_count++];
+    memset(created, 0, sizeof(aggregate_group_t));
+    created->group = group;
+    created->min = UINT32_MAX;
+    init_value_counts(&created->values);
+    return created;
+}
+
+static int add_to_group(aggregate_group_t *group, uint32_t value, uint64_t count) {
+    if (add_value_count(&group->values, value, count) != BIOS_SUCCESS) {
+        return BIOS_ERROR_FILE;
+    }
+    group->count += count;
+    group->sum += (double)value * (double)count;
+    if (value < group->min) {
+        group->min = value;
+    }
+    if (value > group->max) {
+        group->max = value;
+    }
+    return BIOS_SUCCESS;
+}
+
+// Index of name in settings, trying the hint first
+static int locate_setting(const bios_setting_t *settings, int count, const char *name, int *hint) {
+    if (*hint < count && strncmp(settings[*hint].name, name, MAX_SETTING_NAME) == 0) {
+        return *hint;
+    }
+    for (int i = 0; i < count; i++) {
+        if (strncmp(settings[i].name, name, MAX_SETTING_NAME) == 0) {
+            *hint = i;
+            return i;
+        }
+    }
+    return -1;
+}
+
+int aggregate_add_settings(aggregate_t *aggregate, const bios_setting_t *settings, int count) {
+    int index = locate_setting(settings, count, aggregate->setting, &aggregate->setting_hint);
+    uint32_t group = 0;
+    if (index >= 0 && aggregate->group_by[0]) {
+        int group_index = locate_setting(settings, count, aggregate->group_by, &aggregate->group_hint);
+        if (group_index < 0) {
+            index = -1;
+        } else {
+            group = get_setting_value(&settings[group_index]);
+            group -= group % aggregate->group_width;
+        }
+    }
+    if (index < 0) {
+        aggregate->missing++;
+        return BIOS_SUCCESS;
+    }
+
+    aggregate_group_t *target = find_group(aggregate, group);
+    if (!target) {
+        return BIOS_ERROR_FILE;
+    }
+    return add_to_group(target, get_setting_value(&settings[index]), 1);
+}
+
+int aggregate_add_config(aggregate_t *aggregate, const bios_config_t *config) {
+    return aggregate_add_settings(aggregate, config->settings, config->setting_count);
+}
+
+int merge_aggregate(aggregate_t *into, const aggregate_t *from) {
+    if (strcmp(into->setting, from->setting) != 0 || strcmp(into->group_by, from->group_by) != 0 ||
+        into->group_width != from->group_width) {
+        return BIOS_ERROR_INVALID_SETTING;
+    }
+
+    into->missing += from->missing;
+    for (int i = 0; i < from->group_count; i++) {
+        const aggregate_group_t *source = &from->groups[i];
+        aggregate_group_t *target = find_group(into, source->group);
+        if (!target) {
+            return BIOS_ERROR_FILE;
+        }
+        for (size_t slot = 0; slot < source->values.slot_count; slot++) {
+            if (source->values.counts[slot] &&
+                add_value_count(&target->values, source->values.values[slot], source->values.counts[slot]) != BIOS_SUCCESS) {
+                return BIOS_ERROR_FILE;
+            }
+        }
+        target->count += source->count;
+        target->sum += source->sum;
+        if (source->min < target->min) {
+            target->min = source->min;
+        }
+        if (source->max > target->max) {
+            target->max = source->max;
+        }
+    }
+    return BIOS_SUCCESS;
+}
+
+uint32_t aggregate_percentile(const aggregate_group_t *group, double percentile) {
+    value_count_t *sorted = sort_value_counts(&group->values);
+    if (!sorted) {
+        return 0;
+    }
+    uint32_t value = sorted_percentile(sorted, group->values.used, group->count, percentile);
+    free(sorted);
+    return value;
+}
+
+// Output
+
+static int compare_groups(const void *a, const void *b) {
+    uint32_t left = ((const aggregate_group_t*)a)->group;
+    uint32_t right = ((const aggregate_group_t*)b)->group;
+    return (left > right) - (left < right);
+}
+
+// Upper bound of the bucket starting at low, clamped so buckets near UINT32_MAX do not wrap
+static uint32_t last_in_bucket(uint32_t low, uint64_t width) {
+    uint64_t high = (uint64_t)low + width - 1;
+    return high > UINT32_MAX ? UINT32_MAX : (uint32_t)high;
+}
+
+// Histogram rows: one per distinct value when they fit, otherwise equal-width buckets
+static void print_histogram(FILE *out, const value_count_t *sorted, size_t used, uint64_t total,
+                            int buckets, aggregate_format_t format) {
+    uint32_t low = sorted[0].value;
+    uint32_t high = sorted[used - 1].value;
+    // A single bucket over the full 32-bit range is 2^32 wide, so widths stay 64-bit
+    uint64_t width = 1;
+    if (used > (size_t)buckets) {
+        uint64_t span = (uint64_t)high - low + 1;
+        width = (span + (uint64_t)buckets - 1) / (uint64_t)buckets;
+    }
+
+    int first = 1;
+    size_t i = 0;
+    while (i < used) {
+        uint32_t bucket_low = width == 1 ? sorted[i].value : (uint32_t)(low + (sorted[i].value - low) / width * width);
+        uint32_t bucket_high = last_in_bucket(bucket_low, width);
+        uint64_t count = 0;
+        while (i < used && sorted[i].value >= bucket_low && sorted[i].value <= bucket_high) {
+            count += sorted[i].count;
+            i++;
+        }
+
+        double share = 100.0 * (double)count / (double)total;
+        if (format == AGGREGATE_FORMAT_JSON) {
+            fprintf(out, "%s{\"low\": %u, \"high\": %u, \"count\": %.0f}", first ? "" : ", ",
+                    bucket_low, bucket_high, (double)count);
+        } else {
+            char range[32];
+            if (bucket_low == bucket_high) {
+                snprintf(range, sizeof(range), "%u", bucket_low);
+            } else {
+                snprintf(range, sizeof(range), "%u-%u", bucket_low, bucket_high);
+            }
+            int bar = (int)(share / 2.0 + 0.5);
+            fprintf(out, "    %-21s %10.0f %6.1f%%  %.*s\n", range, (double)count, share, bar,
+                    "##################################################");
+        }
+        first = 0;
+    }
+}
+
+static void print_group(FILE *out, const aggregate_t *aggregate, const aggregate_group_t *group,
+                        int histogram_buckets, aggregate_format_t format) {
+    value_count_t *sorted = sort_value_counts(&group->values);
+    if (!sorted) {
+        return;
+    }
+    size_t used = group->values.used;
+    uint32_t p50 = sorted_percentile(sorted, used, group->count, 50);
+    uint32_t p90 = sorted_percentile(sorted, used, group->count, 90);
+    uint32_t p99 = sorted_percentile(sorted, used, group->count, 99);
+    double mean = group->count ? group->sum / (double)group->count : 0;
+
+    if (format == AGGREGATE_FORMAT_JSON) {
+        fprintf(out, "{\"group\": %u, \"count\": %.0f, \"min\": %u, \"max\": %u, \"mean\": %.2f, "
+                     "\"p50\": %u, \"p90\": %u, \"p99\": %u, \"distinct\": %lu, \"histogram\": [",
+                group->group, (double)group->count, group->min, group->max, mean, p50, p90, p99,
+                (unsigned long)used);
+        if (histogram_buckets > 0) {
+            print_histogram(out, sorted, used, group->count, histogram_buckets, format);
+        }
+        fprintf(out, "]}");
+    } else {
+        if (aggregate->group_by[0]) {
+            if (aggregate->group_width > 1) {
+                fprintf(out, "  %s %u-%u:\n", aggregate->group_by, group->group,
+                        last_in_bucket(group->group, aggregate->group_width));
+            } else {
+                fprintf(out, "  %s %u:\n", aggregate->group_by, group->group);
+            }
+        }
+        fprintf(out, "    count %.0f  min %u  max %u  mean %.1f  p50 %u  p90 %u  p99 %u  distinct %lu\n",
+                (double)group->count, group->min, group->max, mean, p50, p90, p99, (unsigned long)used);
+        if (histogram_buckets > 0) {
+            print_histogram(out, sorted, used, group->count, histogram_buckets, format);
+        }
+    }
+    free(sorted);
+}
+
+// Groups are printed in ascending order; histograms only for ungrouped aggregates
+void print_aggregate(FILE *out, aggregate_t *aggregate, int histogram_buckets, aggregate_format_t format) {
+    qsort(aggregate->groups, aggregate->group_count, sizeof(aggregate_group_t), compare_groups);
+    int group_histograms = aggregate->group_by[0] ? 0 : histogram_buckets;
+
+    uint64_t total = 0;
+    for (int i = 0; i < aggregate->group_count; i++) {
+        total += aggregate->groups[i].count;
+    }
+
+    if (format == AGGREGATE_FORMAT_JSON) {
+        fprintf(out, "{\"setting\": \"%s\", \"group_by\": \"%s\", \"group_width\": %u, \"count\": %.0f, "
+                     "\"missing\": %.0f, \"groups\": [",
+                aggregate->setting, aggregate->group_by, aggregate->group_width, (double)total,
+                (double)aggregate->missing);
+        for (int i = 0; i < aggregate->group_count; i++) {
+            fprintf(out, "%s", i ? ", " : "");
+            print_group(out, aggregate, &aggregate->groups[i], group_histograms, format);
+        }
+        fprintf(out, "]}");
+        return;
+    }
+
+    if (aggregate->group_by[0]) {
+        fprintf(out, "%s by %s", aggregate->setting, aggregate->group_by);
+        if (aggregate->group_width > 1) {
+            fprintf(out, "/%u", aggregate->group_width);
+        }
+    } else {
+        fprintf(out, "%s", aggregate->setting);
+    }
+    fprintf(out, " (%.0f configs, %.0f missing)\n", (double)total, (double)aggregate->missing);
+    for (int i = 0; i < aggregate->group_count; i++) {
+        print_group(out, aggregate, &aggregate->groups[i], group_histograms, format);
+    }
+}
+
+// Fleet driver
+
+typedef struct {
+    const fleet_paths_t *paths;
+    aggregate_t *worker_aggregates;     // aggregate_count per worker
+    size_t *worker_failed;
+    int *worker_result;                 // First accumulation error per worker
+    int aggregate_count;
+} aggregate_job_t;
+
+// One file into the calling worker's own aggregates; nothing is shared
+static void aggregate_fleet_file(void *context, size_t index, int worker) {
+    aggregate_job_t *job = context;
+    bios_config_t config;
+    bios_report_t report;
+
+    init_report(&report);
+    if (parse_bios_config_report(job->paths->paths[index], &config, &report) != BIOS_SUCCESS) {
+        job->worker_failed[worker]++;
+        return;
+    }
+    aggregate_t *aggregates = &job->worker_aggregates[(size_t)worker * job->aggregate_count];
+    for (int i = 0; i < job->aggregate_count; i++) {
+        int result = aggregate_add_config(&aggregates[i], &config);
+        if (result != BIOS_SUCCESS && job->worker_result[worker] == BIOS_SUCCESS) {
+            job->worker_result[worker] = result;
+        }
+    }
+}
+
+int aggregate_fleet(const fleet_paths_t *paths, int thread_count, aggregate_t *aggregates, int aggregate_count,
+                    size_t *failed_count) {
+    int workers = thread_count > 0 ? thread_count : get_cpu_count();
+    aggregate_job_t job;
+    job.paths = paths;
+    job.aggregate_count = aggregate_count;
+    job.worker_aggregates = calloc((size_t)workers * aggregate_count, sizeof(aggregate_t));
+    job.worker_failed = calloc((size_t)workers, sizeof(size_t));
+    job.worker_result = calloc((size_t)workers, sizeof(int));
+    if (!job.worker_aggregates || !job.worker_failed || !job.worker_result) {
+        free(job.worker_aggregates);
+        free(job.worker_failed);
+        free(job.worker_result);
+        printf("Error: Cannot allocate aggregation state\n");
+        return BIOS_ERROR_FILE;
+    }
+    for (int w = 0; w < workers; w++) {
+        for (int i = 0; i < aggregate_count; i++) {
+            const aggregate_t *spec = &aggregates[i];
+            init_aggregate(&job.worker_aggregates[(size_t)w * aggregate_count + i], spec->setting,
+                           spec->group_by[0] ? spec->group_by : NULL, spec->group_width);
+        }
+    }
+
+    int result = run_thread_pool(paths->count, workers, aggregate_fleet_file, &job);
+
+    *failed_count = 0;
+    for (int w = 0; w < workers; w++) {
+        *failed_count += job.worker_failed[w];
+        if (result == BIOS_SUCCESS && job.worker_result[w] != BIOS_SUCCESS) {
+            printf("Error: Cannot allocate aggregation state\n");
+            result = job.worker_result[w];
+        }
+        for (int i = 0; i < aggregate_count; i++) {
+            aggregate_t *partial = &job.worker_aggregates[(size_t)w * aggregate_count + i];
+            if (result == BIOS_SUCCESS) {
+                result = merge_aggregate(&aggregates[i], partial);
+            }
+            free_aggregate(partial);
+        }
+    }
+
+    free(job.worker_aggregates);
+    free(job.worker_failed);
+    free(job.worker_result);
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,273 @@
+#include "../include/fleet_loader.h"
+#include "../include/config_parser.h"
+#include "../include/validator.h"
+#include "../include/config_dedup.h"
+#include "../include/thread_pool.h"
+
+#ifdef _WIN32
+#define PATH_SEPARATOR "\\"
+#else
+#include <dirent.h>
+#define PATH_SEPARATOR "/"
+#endif
+
+void init_fleet_paths(fleet_paths_t *paths) {
+    paths->paths = NULL;
+    paths->count = 0;
+    paths->capacity = 0;
+}
+
+int add_fleet_path(fleet_paths_t *paths, const char *path) {
+    if (paths->count == paths->capacity) {
+        size_t capacity = paths->capacity ? paths->capacity * 2 : 64;
+        char **grown = realloc(paths->paths, capacity * sizeof(char*));
+        if (!grown) {
+            return BIOS_ERROR_FILE;
+        }
+        paths->paths = grown;
+        paths->capacity = capacity;
+    }
+
+    size_t len = strlen(path) + 1;
+    char *copy = malloc(len);
+    if (!copy) {
+        return BIOS_ERROR_FILE;
+    }
+    memcpy(copy, path, len);
+    paths->paths[paths->count++] = copy;
+    return BIOS_SUCCESS;
+}
+
+static int has_bin_extension(const char *name) {
+    size_t len = strlen(name);
+    return len > 4 && strcmp(name + len - 4, ".bin") == 0;
+}
+
+static int add_directory_entry(fleet_paths_t *paths, const char *directory, const char *name) {
+    char path[FLEET_PATH_MAX];
+    size_t dir_len = strlen(directory);
+    int needs_separator = dir_len > 0 && directory[dir_len - 1] != '/' && directory[dir_len - 1] != '\\';
+
+    int written = snprintf(path, sizeof(path), "%s%s%s", directory, needs_separator ? PATH_SEPARATOR : "", name);
+    if (written < 0 || (size_t)written >= sizeof(path)) {
+        printf("Warning: Skipping path too long: %s\n", name);
+        return BIOS_SUCCESS;
+    }
+    return add_fleet_path(paths, path);
+}
+
+static int compare_paths(const void *a, const void *b) {
+    return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+// Add every *.bin file in a directory, in name order
+int collect_fleet_directory(fleet_paths_t *paths, const char *directory) {
+    size_t first = paths->count;
+
+#ifdef _WIN32
+    char pattern[FLEET_PATH_MAX];
+    snprintf(pattern, sizeof(pattern), "%s\\*.bin", directory);
+
+    WIN32_FIND_DATAA entry;
+    HANDLE find = FindFirstFileA(pattern, &entry);
+    if (find == INVALID_HANDLE_VALUE) {
+        if (GetLastError() == ERROR_FILE_NOT_FOUND) {
+            return BIOS_SUCCESS;  // Empty directory
+        }
+        printf("Error: Cannot open directory %s\n", directory);
+        return BIOS_ERROR_FILE;
+    }
+    do {
+        if (!(entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) && has_bin_extension(entry.cFileName)) {
+            if (add_directory_entry(paths, directory, entry.cFileName) != BIOS_SUCCESS) {
+                FindClose(find);
+                return BIOS_ERROR_FILE;
+            }
+        }
+    } while (FindNextFileA(find, &entry));
+    FindClose(find);
+#else
+    DIR *dir = opendir(directory);
+    if (!dir) {
+        printf("Error: Cannot open directory %s\n", directory);
+        return BIOS_ERROR_FILE;
+    }
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (has_bin_extension(entry->d_name)) {
+            if (add_directory_entry(paths, directory, entry->d_name) != BIOS_SUCCESS) {
+                closedir(dir);
+                return BIOS_ERROR_FILE;
+            }
+        }
+    }
+    closedir(dir);
+#endif
+
+    qsort(paths->paths + first, paths->count - first, sizeof(char*), compare_paths);
+    return BIOS_SUCCESS;
+}
+
+// Add every path listed in a text file, one per line
+int collect_fleet_list(fleet_paths_t *paths, const char *list_file) {
+    FILE *file = fopen(list_file, "r");
+    if (!file) {
+        printf("Error: Cannot open file %s\n", list_file);
+        return BIOS_ERROR_FILE;
+    }
+
+    char line[FLEET_PATH_MAX];
+    while (fgets(line, sizeof(line), file) != NULL) {
+        size_t len = strlen(line);
+        while (len > 0 && (line[len-1] == '\n' || line[len-1] == '\r' || line[len-1] == ' ')) {
+            line[--len] = '\0';
+        }
+        if (len == 0 || line[0] == '#') {
+            continue;
+        }
+        if (add_fleet_path(paths, line) != BIOS_SUCCESS) {
+            fclose(file);
+            return BIOS_ERROR_FILE;
+        }
+    }
+
+    fclose(file);
+    return BIOS_SUCCESS;
+}
+
+void free_fleet_paths(fleet_paths_t *paths) {
+    for (size_t i = 0; i < paths->count; i++) {
+        free(paths->paths[i]);
+    }
+    free(paths->paths);
+    init_fleet_paths(paths);
+}
+
+typedef struct {
+    fleet_report_t *report;
+    dedup_store_t *worker_stores;   // One per worker: validation results by settings payload
+} fleet_job_t;
+
+// Validate through the worker's store, keyed by file index; validate directly if it cannot store
+static int validate_fleet_config(dedup_store_t *store, size_t index, const bios_config_t *config,
+                                 bios_report_t *report) {
+    char machine[24];
+    snprintf(machine, sizeof(machine), "%lu", (unsigned long)index);
+    if (dedup_store_put(store, machine, config) != BIOS_SUCCESS) {
+        return validate_all_settings(config, report);
+    }
+    return dedup_store_validate(store, machine, report);
+}
+
+// One file: parse -> checksum -> validate. Touches only its own result slot and worker store.
+static void load_fleet_file(void *context, size_t index, int worker) {
+    fleet_job_t *job = context;
+    fleet_file_result_t *result = &job->report->files[index];
+    bios_config_t config;
+
+    init_report(&result->report);
+    result->parse_result = parse_bios_config_report(result->path, &config, &result->report);
+    if (result->parse_result != BIOS_SUCCESS) {
+        return;
+    }
+
+    result->setting_count = config.setting_count;
+    result->checksum_ok = !config.checksum_stale;
+    result->validation_result = validate_fleet_config(&job->worker_stores[worker], index, &config, &result->report);
+}
+
+int load_fleet(const fleet_paths_t *paths, int thread_count, fleet_report_t *report) {
+    memset(report, 0, sizeof(fleet_report_t));
+    report->files = calloc(paths->count ? paths->count : 1, sizeof(fleet_file_result_t));
+    if (!report->files) {
+        return BIOS_ERROR_FILE;
+    }
+    report->file_count = paths->count;
+    for (size_t i = 0; i < paths->count; i++) {
+        report->files[i].path = paths->paths[i];
+    }
+
+    int workers = thread_count > 0 ? thread_count : get_cpu_count();
+    fleet_job_t job;
+    job.report = report;
+    job.worker_stores = calloc((size_t)workers, sizeof(dedup_store_t));
+    if (!job.worker_stores) {
+        return BIOS_ERROR_FILE;
+    }
+    for (int w = 0; w < workers; w++) {
+        init_dedup_store(&job.worker_stores[w]);
+    }
+
+    int result = run_thread_pool(paths->count, workers, load_fleet_file, &job);
+    for (int w = 0; w < workers; w++) {
+        dedup_stats_t stats;
+        get_dedup_stats(&job.worker_stores[w], &stats);
+        report->validations_run += stats.validations_run;
+        report->validations_cached += stats.validations_cached;
+        free_dedup_store(&job.worker_stores[w]);
+    }
+    free(job.worker_stores);
+    if (result != BIOS_SUCCESS) {
+        return result;
+    }
+
+    // Gather totals
+    for (size_t i = 0; i < report->file_count; i++) {
+        const fleet_file_result_t *file = &report->files[i];
+        if (file->parse_result != BIOS_SUCCESS) {
+            report->failed_count++;
+            continue;
+        }
+        report->loaded_count++;
+        if (!file->checksum_ok) {
+            report->checksum_error_count++;
+        }
+        if (file->validation_result != BIOS_SUCCESS) {
+            report->invalid_count++;
+        }
+        // The checksum mismatch is itself reported as a warning; count only the others
+        if (file->report.warning_count > (file->checksum_ok ? 0 : 1)) {
+            report->warning_count++;
+        }
+    }
+    return BIOS_SUCCESS;
+}
+
+// Print the summary, plus per-file details for problem files (or all files when verbose)
+void print_fleet_report(const fleet_report_t *report, int verbose) {
+    for (size_t i = 0; i < report->file_count; i++) {
+        const fleet_file_result_t *file = &report->files[i];
+        const char *status;
+        if (file->parse_result != BIOS_SUCCESS) {
+            status = "FAILED";
+        } else if (file->validation_result != BIOS_SUCCESS) {
+            status = "INVALID";
+        } else if (!file->checksum_ok) {
+            status = "CHECKSUM";
+        } else if (file->report.warning_count > 0) {
+            status = "WARNING";
+        } else {
+            status = "OK";
+        }
+
+        if (verbose || strcmp(status, "OK") != 0) {
+            printf("%-8s %s\n", status, file->path);
+            print_report(&file->report);
+        }
+    }
+
+    printf("\n=== Fleet Summary ===\n");
+    printf("Files: %lu\n", (unsigned long)report->file_count);
+    printf("Loaded: %lu\n", (unsigned long)report->loaded_count);
+    printf("Failed to load: %lu\n", (unsigned long)report->failed_count);
+    printf("Checksum mismatches: %lu\n", (unsigned long)report->checksum_error_count);
+    printf("Validation errors: %lu\n", (unsigned long)report->invalid_count);
+    printf("With warnings: %lu\n", (unsigned long)report->warning_count);
+    printf("Validations: %lu run, %lu cached\n", (unsigned long)report->validations_run,
+           (unsigned long)report->validations_cached);
+}
+
+void free_fleet_report(fleet_report_t *report) {
+    free(report->files);
+    memset(report, 0, sizeof(fleet_report_t));
+}
\ No newline at end of file
@@ -0,0 +1,320 @@
+#include "../include/fleet_store.h"
+#include "../include/config_parser.h"
+#include "../include/name_index.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FLEET_STORE_X86 1
+#include <immintrin.h>
+#endif
+
+int init_fleet_store(fleet_store_t *store, size_t initial_rows) {
+    memset(store, 0, sizeof(fleet_store_t));
+    store->row_capacity = initial_rows > 0 ? initial_rows : 1024;
+    store->node_ids = malloc(sizeof(uint32_t) * store->row_capacity);
+    store->column_slot_count = 64;
+    store->column_slots = calloc(store->column_slot_count, sizeof(uint16_t));
+    if (!store->node_ids || !store->column_slots) {
+        free_fleet_store(store);
+        return BIOS_ERROR_FILE;
+    }
+    return BIOS_SUCCESS;
+}
+
+void free_fleet_store(fleet_store_t *store) {
+    for (int i = 0; i < store->column_count; i++) {
+        free(store->columns[i].values);
+        free(store->columns[i].present);
+    }
+    free(store->columns);
+    free(store->column_slots);
+    free(store->node_ids);
+    memset(store, 0, sizeof(fleet_store_t));
+}
+
+int fleet_store_find_column(const fleet_store_t *store, const char *name) {
+    size_t mask = store->column_slot_count - 1;
+    size_t slot = hash_setting_name(name) & mask;
+
+    while (store->column_slots[slot] != 0) {
+        int column = store->column_slots[slot] - 1;
+        if (strncmp(store->columns[column].name, name, MAX_SETTING_NAME) == 0) {
+            return column;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return BIOS_ERROR_INVALID_SETTING;
+}
+
+static void insert_column_slot(fleet_store_t *store, int column) {
+    size_t mask = store->column_slot_count - 1;
+    size_t slot = hash_setting_name(store->columns[column].name) & mask;
+    while (store->column_slots[slot] != 0) {
+        slot = (slot + 1) & mask;
+    }
+    store->column_slots[slot] = (uint16_t)(column + 1);
+}
+
+// Intern a setting name, creating an empty column for it on first sight
+static int intern_column(fleet_store_t *store, const bios_setting_t *setting) {
+    int column = fleet_store_find_column(store, setting->name);
+    if (column >= 0) {
+        return column;
+    }
+    if (store->column_count >= UINT16_MAX - 1) {
+        return BIOS_ERROR_FORMAT;
+    }
+
+    if (store->column_count == store->column_capacity) {
+        int capacity = store->column_capacity ? store->column_capacity * 2 : 32;
+        fleet_column_t *grown = realloc(store->columns, sizeof(fleet_column_t) * capacity);
+        if (!grown) {
+            return BIOS_ERROR_FILE;
+        }
+        store->columns = grown;
+        store->column_capacity = capacity;
+    }
+
+    // Keep the name table at most half full
+    if ((size_t)(store->column_count + 1) * 2 > store->column_slot_count) {
+        size_t slot_count = store->column_slot_count * 2;
+        uint16_t *slots = calloc(slot_count, sizeof(uint16_t));
+        if (!slots) {
+            return BIOS_ERROR_FILE;
+        }
+        free(store->column_slots);
+        store->column_slots = slots;
+        store->column_slot_count = slot_count;
+        for (int i = 0; i < store->column_count; i++) {
+            insert_column_slot(store, i);
+        }
+    }
+
+    fleet_column_t *entry = &store->columns[store->column_count];
+    memset(entry, 0, sizeof(fleet_column_t));
+    memcpy(entry->name, setting->name, MAX_SETTING_NAME);
+    entry->name[MAX_SETTING_NAME - 1] = '\0';
+    entry->type = setting->type;
+    entry->values = calloc(store->row_capacity, sizeof(uint32_t));
+    entry->present = calloc(store->row_capacity, sizeof(uint8_t));
+    if (!entry->values || !entry->present) {
+        free(entry->values);
+        free(entry->present);
+        return BIOS_ERROR_FILE;
+    }
+
+    column = store->column_count++;
+    insert_column_slot(store, column);
+    return column;
+}
+
+static int grow_rows(fleet_store_t *store) {
+    size_t capacity = store->row_capacity * 2;
+
+    uint32_t *node_ids = realloc(store->node_ids, sizeof(uint32_t) * capacity);
+    if (!node_ids) {
+        return BIOS_ERROR_FILE;
+    }
+    store->node_ids = node_ids;
+
+    for (int i = 0; i < store->column_count; i++) {
+        fleet_column_t *column = &store->columns[i];
+        uint32_t *values = realloc(column->values, sizeof(uint32_t) * capacity);
+        if (!values) {
+            return BIOS_ERROR_FILE;
+        }
+        column->values = values;
+        uint8_t *present = realloc(column->present, capacity);
+        if (!present) {
+            return BIOS_ERROR_FILE;
+        }
+        memset(present + store->row_capacity, 0, capacity - store->row_capacity);
+        column->present = present;
+    }
+
+    store->row_capacity = capacity;
+    return BIOS_SUCCESS;
+}
+
+// Append one config as a new row
+int fleet_store_add_settings(fleet_store_t *store, uint32_t node_id, const bios_setting_t *settings, int count) {
+    if (store->row_count == store->row_capacity && grow_rows(store) != BIOS_SUCCESS) {
+        return BIOS_ERROR_FILE;
+    }
+
+    size_t row = store->row_count;
+    for (int i = 0; i < count; i++) {
+        int column = intern_column(store, &settings[i]);
+        if (column < 0) {
+            // Undo the partial row
+            for (int c = 0; c < store->column_count; c++) {
+                store->columns[c].present[row] = 0;
+            }
+            return column;
+        }
+        store->columns[column].values[row] = get_setting_value(&settings[i]);
+        store->columns[column].present[row] = 1;
+    }
+
+    store->node_ids[row] = node_id;
+    store->row_count++;
+    return BIOS_SUCCESS;
+}
+
+int fleet_store_add_config(fleet_store_t *store, uint32_t node_id, const bios_config_t *config) {
+    return fleet_store_add_settings(store, node_id, config->settings, config->setting_count);
+}
+
+int fleet_store_add_view(fleet_store_t *store, uint32_t node_id, const bios_config_view_t *view) {
+    return fleet_store_add_settings(store, node_id, view->settings, view->setting_count);
+}
+
+// Predicate kernels: mask[i] &= present[i] && (values[i] op operand)
+static int compare_value(uint32_t value, fleet_op_t op, uint32_t operand) {
+    switch (op) {
+        case FLEET_OP_EQ: return value == operand;
+        case FLEET_OP_NE: return value != operand;
+        case FLEET_OP_LT: return value < operand;
+        case FLEET_OP_LE: return value <= operand;
+        case FLEET_OP_GT: return value > operand;
+        case FLEET_OP_GE: return value >= operand;
+        default: return 0;
+    }
+}
+
+static void apply_predicate_scalar(const uint32_t *values, const uint8_t *present, size_t count,
+                                   fleet_op_t op, uint32_t operand, uint8_t *mask) {
+    for (size_t i = 0; i < count; i++) {
+        mask[i] &= present[i] & (uint8_t)compare_value(values[i], op, operand);
+    }
+}
+
+#ifdef FLEET_STORE_X86
+// Unsigned compares via the signed SSE2 compares on sign-flipped lanes
+__attribute__((target("sse2")))
+static inline __m128i compare_lanes_sse2(__m128i values, fleet_op_t op, __m128i operand, __m128i biased_operand) {
+    const __m128i bias = _mm_set1_epi32((int)0x80000000u);
+    const __m128i all_ones = _mm_set1_epi32(-1);
+    __m128i biased = _mm_xor_si128(values, bias);
+
+    switch (op) {
+        case FLEET_OP_EQ: return _mm_cmpeq_epi32(values, operand);
+        case FLEET_OP_NE: return _mm_andnot_si128(_mm_cmpeq_epi32(values, operand), all_ones);
+        case FLEET_OP_LT: return _mm_cmplt_epi32(biased, biased_operand);
+        case FLEET_OP_LE: return _mm_andnot_si128(_mm_cmpgt_epi32(biased, biased_operand), all_ones);
+        case FLEET_OP_GT: return _mm_cmpgt_epi32(biased, biased_operand);
+        case FLEET_OP_GE: return _mm_andnot_si128(_mm_cmplt_epi32(biased, biased_operand), all_ones);
+        default: return _mm_setzero_si128();
+    }
+}
+
+// 16 rows per step: four 32-bit compares narrowed to one byte mask
+__attribute__((target("sse2")))
+static void apply_predicate_sse2(const uint32_t *values, const uint8_t *present, size_t count,
+                                 fleet_op_t op, uint32_t operand, uint8_t *mask) {
+    const __m128i target = _mm_set1_epi32((int)operand);
+    const __m128i biased_target = _mm_xor_si128(target, _mm_set1_epi32((int)0x80000000u));
+    size_t i = 0;
+
+    for (; i + 16 <= count; i += 16) {
+        __m128i r0 = compare_lanes_sse2(_mm_loadu_si128((const __m128i*)(values + i)), op, target, biased_target);
+        __m128i r1 = compare_lanes_sse2(_mm_loadu_si128((const __m128i*)(values + i + 4)), op, target, biased_target);
+        __m128i r2 = compare_lanes_sse2(_mm_loadu_si128((const __m128i*)(values + i + 8)), op, target, biased_target);
+        __m128i r3 = compare_lanes_sse2(_mm_loadu_si128((const __m128i*)(values + i + 12)), op, target, biased_target);
+        __m128i hits = _mm_packs_epi16(_mm_packs_epi32(r0, r1), _mm_packs_epi32(r2, r3));
+
+        __m128i row_mask = _mm_loadu_si128((const __m128i*)(mask + i));
+        __m128i row_present = _mm_loadu_si128((const __m128i*)(present + i));
+        row_mask = _mm_and_si128(row_mask, _mm_and_si128(hits, row_present));
+        _mm_storeu_si128((__m128i*)(mask + i), row_mask);
+    }
+    apply_predicate_scalar(values + i, present + i, count - i, op, operand, mask + i);
+}
+#endif
+
+static void apply_predicate(const uint32_t *values, const uint8_t *present, size_t count,
+                            fleet_op_t op, uint32_t operand, uint8_t *mask) {
+#ifdef FLEET_STORE_X86
+    if (__builtin_cpu_supports("sse2")) {
+        apply_predicate_sse2(values, present, count, op, operand, mask);
+        return;
+    }
+#endif
+    apply_predicate_scalar(values, present, count, op, operand, mask);
+}
+
+// Evaluate all predicates over rows [begin, begin + count) into mask (0/1 per row)
+static size_t evaluate_block(const fleet_store_t *store, const fleet_predicate_t *predicates, int predicate_count,
+                             size_t begin, size_t count, uint8_t *mask) {
+    memset(mask, 1, count);
+
+    for (int p = 0; p < predicate_count; p++) {
+        int column = fleet_store_find_column(store, predicates[p].name);
+        if (column < 0) {
+            memset(mask, 0, count);  // Unknown setting: nothing matches
+            return 0;
+        }
+        const fleet_column_t *entry = &store->columns[column];
+        apply_predicate(entry->values + begin, entry->present + begin, count,
+                        predicates[p].op, predicates[p].value, mask);
+    }
+
+    size_t matched = 0;
+    for (size_t i = 0; i < count; i++) {
+        matched += mask[i];
+    }
+    return matched;
+}
+
+size_t fleet_store_filter(const fleet_store_t *store, const fleet_predicate_t *predicates, int predicate_count,
+                          uint8_t *row_mask) {
+    size_t matched = 0;
+    for (size_t begin = 0; begin < store->row_count; begin += FLEET_STORE_BLOCK_ROWS) {
+        size_t count = store->row_count - begin;
+        if (count > FLEET_STORE_BLOCK_ROWS) {
+            count = FLEET_STORE_BLOCK_ROWS;
+        }
+        matched += evaluate_block(store, predicates, predicate_count, begin, count, row_mask + begin);
+    }
+    return matched;
+}
+
+size_t fleet_store_count(const fleet_store_t *store, const fleet_predicate_t *predicates, int predicate_count) {
+    uint8_t mask[FLEET_STORE_BLOCK_ROWS];
+    size_t matched = 0;
+
+    for (size_t begin = 0; begin < store->row_count; begin += FLEET_STORE_BLOCK_ROWS) {
+        size_t count = store->row_count - begin;
+        if (count > FLEET_STORE_BLOCK_ROWS) {
+            count = FLEET_STORE_BLOCK_ROWS;
+        }
+        matched += evaluate_block(store, predicates, predicate_count, begin, count, mask);
+    }
+    return matched;
+}
+
+// Collect the node ids of matching rows; returns the total number of matches,
+// which may exceed max_ids
+size_t fleet_store_select(const fleet_store_t *store, const fleet_predicate_t *predicates, int predicate_count,
+                          uint32_t *node_ids, size_t max_ids) {
+    uint8_t mask[FLEET_STORE_BLOCK_ROWS];
+    size_t matched = 0;
+
+    for (size_t begin = 0; begin < store->row_count; begin += FLEET_STORE_BLOCK_ROWS) {
+        size_t count = store->row_count - begin;
+        if (count > FLEET_STORE_BLOCK_ROWS) {
+            count = FLEET_STORE_BLOCK_ROWS;
+        }
+        if (evaluate_block(store, predicates, predicate_count, begin, count, mask) == 0) {
+            continue;
+        }
+        for (size_t i = 0; i < count; i++) {
+            if (mask[i]) {
+                if (matched < max_ids) {
+                    node_ids[matched] = store->node_ids[begin + i];
+                }
+                matched++;
+            }
+        }
+    }
+    return matched;
+}
\ No newline at end of file
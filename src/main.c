@@ -1,31 +1,403 @@
 #include "../include/config_parser.h"
+#include "../include/config_cache.h"
 #include "../include/setup_menu.h"
 #include "../include/validator.h"
+#include "../include/fleet_loader.h"
+#include "../include/fleet_aggregate.h"
+#include "../include/config_export.h"
+#include "../include/config_import.h"
+#include "../include/batch_runner.h"
+#include "../include/config_daemon.h"
+#include "../include/stats.h"
+#include <signal.h>
 
-int main(void) {
+static void print_usage(const char *program) {
+    printf("Usage: %s                                   Interactive mode\n", program);
+    printf("       %s --fleet <dir> [options]           Validate every *.bin in a directory\n", program);
+    printf("       %s --fleet-list <file> [options]     Validate the files listed in a text file\n", program);
+    printf("       %s --aggregate <dir> --stat SPEC ... Distributions of settings across a fleet\n", program);
+    printf("       %s --aggregate-list <file> --stat SPEC ...\n", program);
+    printf("       %s --export <dir> [options]          Export every *.bin as JSON Lines or CSV\n", program);
+    printf("       %s --export-list <file> [options]\n", program);
+    printf("       %s --import <file> --output <bin>    Compile a JSON or INI description to a config file\n", program);
+    printf("       %s --import-lines <file> --output-dir <dir> [--no-flush]\n", program);
+    printf("                                                   Compile one JSON record per line\n");
+    printf("       %s --batch <config> [operations]     Apply get/set/validate/save operations\n", program);
+    printf("       %s --daemon <socket>                 Serve config queries on a Unix socket (Linux)\n", program);
+    printf("\nFleet options:\n");
+    printf("   --threads N    Worker threads (default: one per core)\n");
+    printf("   --verbose      Report every file, not only problem files\n");
+    printf("   --stats        Print per-phase timings (text)\n");
+    printf("   --stats-json   Print per-phase timings (JSON)\n");
+    printf("\nAggregate options (--threads as above):\n");
+    printf("   --stat SPEC    SETTING or SETTING:GROUP_SETTING[/WIDTH], repeatable\n");
+    printf("   --histogram N  Histogram rows per ungrouped stat, 0 for none (default: %d)\n", AGGREGATE_DEFAULT_BUCKETS);
+    printf("   --json         Print results as JSON\n");
+    printf("\nExport options (--threads as above):\n");
+    printf("   --format F     jsonl (one object per config, default) or csv (one row per setting)\n");
+    printf("   --output FILE  Write to FILE instead of standard output\n");
+    printf("\nBatch operations (applied in order, file written once at the end):\n");
+    printf("   --script FILE  Read operations from FILE, one per line (- for stdin)\n");
+    printf("   -e OP          One operation, e.g. -e \"set CPU_FREQ 3600\" -e save\n");
+}
+
+// Non-interactive fleet validation
+static int run_fleet_mode(int argc, char *argv[]) {
+    fleet_paths_t paths;
+    fleet_report_t report;
+    int thread_count = 0;
+    int verbose = 0;
+    int show_stats = 0;
+    stats_format_t stats_format = STATS_FORMAT_TEXT;
+    int result = BIOS_SUCCESS;
+
+    init_fleet_paths(&paths);
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--fleet") == 0 && i + 1 < argc) {
+            result = collect_fleet_directory(&paths, argv[++i]);
+        } else if (strcmp(argv[i], "--fleet-list") == 0 && i + 1 < argc) {
+            result = collect_fleet_list(&paths, argv[++i]);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            thread_count = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--verbose") == 0) {
+            verbose = 1;
+        } else if (strcmp(argv[i], "--stats") == 0) {
+            show_stats = 1;
+            stats_format = STATS_FORMAT_TEXT;
+        } else if (strcmp(argv[i], "--stats-json") == 0) {
+            show_stats = 1;
+            stats_format = STATS_FORMAT_JSON;
+        } else {
+            print_usage(argv[0]);
+            free_fleet_paths(&paths);
+            return 1;
+        }
+        if (result != BIOS_SUCCESS) {
+            free_fleet_paths(&paths);
+            return 1;
+        }
+    }
+
+    if (load_fleet(&paths, thread_count, &report) != BIOS_SUCCESS) {
+        printf("Error: Fleet validation failed\n");
+        free_fleet_paths(&paths);
+        return 1;
+    }
+
+    print_fleet_report(&report, verbose);
+    if (show_stats) {
+        stats_dump(stdout, stats_format);
+    }
+    int exit_code = (report.failed_count || report.invalid_count || report.checksum_error_count) ? 1 : 0;
+
+    free_fleet_report(&report);
+    free_fleet_paths(&paths);
+    return exit_code;
+}
+
+// Non-interactive fleet aggregation
+static int run_aggregate_mode(int argc, char *argv[]) {
+    fleet_paths_t paths;
+    aggregate_t aggregates[AGGREGATE_MAX_STATS];
+    int aggregate_count = 0;
+    int thread_count = 0;
+    int histogram_buckets = AGGREGATE_DEFAULT_BUCKETS;
+    aggregate_format_t format = AGGREGATE_FORMAT_TEXT;
+    int result = BIOS_SUCCESS;
+
+    init_fleet_paths(&paths);
+    for (int i = 1; i < argc && result == BIOS_SUCCESS; i++) {
+        if (strcmp(argv[i], "--aggregate") == 0 && i + 1 < argc) {
+            result = collect_fleet_directory(&paths, argv[++i]);
+        } else if (strcmp(argv[i], "--aggregate-list") == 0 && i + 1 < argc) {
+            result = collect_fleet_list(&paths, argv[++i]);
+        } else if (strcmp(argv[i], "--stat") == 0 && i + 1 < argc) {
+            if (aggregate_count == AGGREGATE_MAX_STATS) {
+                printf("Error: At most %d --stat options\n", AGGREGATE_MAX_STATS);
+                result = BIOS_ERROR_INVALID_SETTING;
+            } else if ((result = parse_aggregate_spec(argv[++i], &aggregates[aggregate_count])) == BIOS_SUCCESS) {
+                aggregate_count++;
+            }
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            thread_count = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--histogram") == 0 && i + 1 < argc) {
+            histogram_buckets = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--json") == 0) {
+            format = AGGREGATE_FORMAT_JSON;
+        } else {
+            print_usage(argv[0]);
+            result = BIOS_ERROR_INVALID_SETTING;
+        }
+    }
+    if (result == BIOS_SUCCESS && aggregate_count == 0) {
+        printf("Error: No --stat given\n");
+        result = BIOS_ERROR_INVALID_SETTING;
+    }
+
+    size_t failed_count = 0;
+    if (result == BIOS_SUCCESS &&
+        aggregate_fleet(&paths, thread_count, aggregates, aggregate_count, &failed_count) != BIOS_SUCCESS) {
+        printf("Error: Fleet aggregation failed\n");
+        result = BIOS_ERROR_FILE;
+    }
+
+    if (result == BIOS_SUCCESS) {
+        if (format == AGGREGATE_FORMAT_JSON) {
+            printf("{\"files\": %lu, \"failed\": %lu, \"stats\": [",
+                   (unsigned long)paths.count, (unsigned long)failed_count);
+            for (int i = 0; i < aggregate_count; i++) {
+                printf("%s", i ? ", " : "");
+                print_aggregate(stdout, &aggregates[i], histogram_buckets, format);
+            }
+            printf("]}\n");
+        } else {
+            printf("Aggregated %lu files (%lu failed to parse)\n\n",
+                   (unsigned long)paths.count, (unsigned long)failed_count);
+            for (int i = 0; i < aggregate_count; i++) {
+                print_aggregate(stdout, &aggregates[i], histogram_buckets, format);
+                printf("\n");
+            }
+        }
+    }
+
+    for (int i = 0; i < aggregate_count; i++) {
+        free_aggregate(&aggregates[i]);
+    }
+    free_fleet_paths(&paths);
+    return result == BIOS_SUCCESS ? 0 : 1;
+}
+
+// Non-interactive JSON Lines/CSV export
+static int run_export_mode(int argc, char *argv[]) {
+    fleet_paths_t paths;
+    config_exporter_t exporter;
+    export_format_t format = EXPORT_FORMAT_JSONL;
+    const char *output = NULL;
+    int thread_count = 0;
+    int result = BIOS_SUCCESS;
+
+    init_fleet_paths(&paths);
+    for (int i = 1; i < argc && result == BIOS_SUCCESS; i++) {
+        if (strcmp(argv[i], "--export") == 0 && i + 1 < argc) {
+            result = collect_fleet_directory(&paths, argv[++i]);
+        } else if (strcmp(argv[i], "--export-list") == 0 && i + 1 < argc) {
+            result = collect_fleet_list(&paths, argv[++i]);
+        } else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+            result = parse_export_format(argv[++i], &format);
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            output = argv[++i];
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            thread_count = atoi(argv[++i]);
+        } else {
+            print_usage(argv[0]);
+            result = BIOS_ERROR_INVALID_SETTING;
+        }
+    }
+    if (result != BIOS_SUCCESS) {
+        free_fleet_paths(&paths);
+        return 1;
+    }
+
+    FILE *out = output ? fopen(output, "wb") : stdout;
+    if (!out) {
+        printf("Error: Cannot create file %s\n", output);
+        free_fleet_paths(&paths);
+        return 1;
+    }
+
+    size_t failed_count = 0;
+    result = open_config_exporter(&exporter, out, format, 0);
+    if (result == BIOS_SUCCESS) {
+        result = export_fleet(&paths, thread_count, &exporter, &failed_count);
+        if (close_config_exporter(&exporter) != BIOS_SUCCESS) {
+            result = BIOS_ERROR_FILE;
+        }
+    }
+    if (output && fclose(out) != 0) {
+        printf("Error: Cannot write %s\n", output);
+        result = BIOS_ERROR_FILE;
+    }
+
+    // Standard output carries the data, so only report when writing to a file
+    if (output && result == BIOS_SUCCESS) {
+        printf("Exported %lu configurations to %s (%.0f bytes, %lu failed to parse)\n",
+               (unsigned long)exporter.record_count, output, (double)exporter.bytes_written,
+               (unsigned long)failed_count);
+    }
+
+    free_fleet_paths(&paths);
+    return (result == BIOS_SUCCESS && failed_count == 0) ? 0 : 1;
+}
+
+// Non-interactive JSON/INI compilation
+static int run_import_mode(int argc, char *argv[]) {
+    const char *output = NULL;
+    const char *output_dir = NULL;
+    int lines = strcmp(argv[1], "--import-lines") == 0;
+
+    if (argc < 3) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    const char *input = argv[2];
+    for (int i = 3; i < argc; i++) {
+        if (!lines && strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            output = argv[++i];
+        } else if (lines && strcmp(argv[i], "--output-dir") == 0 && i + 1 < argc) {
+            output_dir = argv[++i];
+        } else if (lines && strcmp(argv[i], "--no-flush") == 0) {
+            set_save_durability(SAVE_DURABILITY_NONE);
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (lines) {
+        size_t compiled_count, failed_count;
+        if (!output_dir) {
+            print_usage(argv[0]);
+            return 1;
+        }
+        int result = compile_config_lines(input, output_dir, &compiled_count, &failed_count);
+        printf("Compiled %lu records into %s (%lu failed)\n",
+               (unsigned long)compiled_count, output_dir, (unsigned long)failed_count);
+        return (result == BIOS_SUCCESS && failed_count == 0) ? 0 : 1;
+    }
+
+    bios_report_t report;
+    if (!output) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    init_report(&report);
+    int result = compile_config_file(input, output, &report);
+    print_report(&report);
+    if (result == BIOS_SUCCESS) {
+        printf("Compiled %s into %s\n", input, output);
+    }
+    return result == BIOS_SUCCESS ? 0 : 1;
+}
+
+// Non-interactive get/set/validate/save against one configuration
+static int run_batch_mode(int argc, char *argv[]) {
+    if (argc < 3) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    // Results can run to hundreds of thousands of lines
+    setvbuf(stdout, NULL, _IOFBF, 1 << 16);
+
+    batch_session_t session;
+    if (open_batch_session(&session, argv[2], stdout) != BIOS_SUCCESS) {
+        return 1;
+    }
+
+    size_t inline_count = 0;
+    for (int i = 3; i < argc; i++) {
+        if (strcmp(argv[i], "-e") == 0 && i + 1 < argc) {
+            // Inline operations are numbered in the order they were given
+            char line[BATCH_LINE_MAX];
+            snprintf(line, sizeof(line), "%s", argv[++i]);
+            run_batch_command(&session, line, ++inline_count);
+        } else if (strcmp(argv[i], "--script") == 0 && i + 1 < argc) {
+            const char *script_path = argv[++i];
+            FILE *script = strcmp(script_path, "-") == 0 ? stdin : fopen(script_path, "r");
+            if (!script) {
+                printf("Error: Cannot open file %s\n", script_path);
+                return 1;
+            }
+            run_batch_script(&session, script);
+            if (script != stdin) {
+                fclose(script);
+            }
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    int result = close_batch_session(&session);
+    fflush(stdout);
+    return result == BIOS_SUCCESS ? 0 : 1;
+}
+
+static config_daemon_t *running_daemon;
+
+static void handle_stop_signal(int signal_number) {
+    (void)signal_number;
+    stop_config_daemon(running_daemon);
+}
+
+// Keep configurations loaded and answer client requests until interrupted
+static int run_daemon_mode(int argc, char *argv[]) {
+    if (argc != 3) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    static config_daemon_t daemon;
+    if (open_config_daemon(&daemon, argv[2]) != BIOS_SUCCESS) {
+        return 1;
+    }
+    running_daemon = &daemon;
+    signal(SIGINT, handle_stop_signal);
+    signal(SIGTERM, handle_stop_signal);
+
+    printf("Config daemon listening on %s\n", argv[2]);
+    fflush(stdout);
+    int result = run_config_daemon(&daemon);
+    printf("Config daemon stopped after %lu requests\n", (unsigned long)daemon.request_count);
+
+    close_config_daemon(&daemon);
+    return result == BIOS_SUCCESS ? 0 : 1;
+}
+
+int main(int argc, char *argv[]) {
     bios_config_t config;
     
+    if (argc > 1) {
+        if (strcmp(argv[1], "--fleet") == 0 || strcmp(argv[1], "--fleet-list") == 0) {
+            return run_fleet_mode(argc, argv);
+        }
+        if (strcmp(argv[1], "--aggregate") == 0 || strcmp(argv[1], "--aggregate-list") == 0) {
+            return run_aggregate_mode(argc, argv);
+        }
+        if (strcmp(argv[1], "--export") == 0 || strcmp(argv[1], "--export-list") == 0) {
+            return run_export_mode(argc, argv);
+        }
+        if (strcmp(argv[1], "--import") == 0 || strcmp(argv[1], "--import-lines") == 0) {
+            return run_import_mode(argc, argv);
+        }
+        if (strcmp(argv[1], "--batch") == 0) {
+            return run_batch_mode(argc, argv);
+        }
+        if (strcmp(argv[1], "--daemon") == 0) {
+            return run_daemon_mode(argc, argv);
+        }
+        print_usage(argv[0]);
+        return 1;
+    }
+    
     printf("=================================\n");
     printf("   BIOS Configuration Manager\n");
     printf("=================================\n\n");
     
     printf("Loading system configuration...\n");
-    if (parse_bios_config("configs\\default.bin", &config) != BIOS_SUCCESS) {
+    if (load_cached_config("configs\\default.bin", &config, NULL) != BIOS_SUCCESS) {
         printf("Initializing default configuration...\n");
         load_default_config(&config);
         save_bios_config("configs\\default.bin", &config);
     }
     
     printf("\nSystem validation...\n");
-    if (validate_cpu_settings(&config) == BIOS_SUCCESS &&
-        validate_memory_settings(&config) == BIOS_SUCCESS &&
-        validate_boot_settings(&config) == BIOS_SUCCESS) {
+    if (validate_config(&config) == BIOS_SUCCESS) {
         printf("✓ Configuration validation passed\n");
     } else {
         printf("⚠ Configuration has validation warnings\n");
     }
     
-    detect_setting_conflicts(&config);
     display_config_summary(&config);
     
     printf("\n=== System Options ===\n");
@@ -0,0 +1,60 @@
+#include "../include/name_index.h"
+
+// FNV-1a over the name, bounded by the on-disk field width
+uint32_t hash_setting_name(const char *name) {
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < MAX_SETTING_NAME && name[i] != '\0'; i++) {
+        hash ^= (uint8_t)name[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Build the index; on duplicate names the first setting wins, as with a linear scan
+void build_name_index(uint16_t *slots, size_t slot_count, const bios_setting_t *settings, int count) {
+    size_t mask = slot_count - 1;
+    memset(slots, 0, sizeof(uint16_t) * slot_count);
+
+    for (int i = 0; i < count; i++) {
+        size_t slot = hash_setting_name(settings[i].name) & mask;
+        while (slots[slot] != 0) {
+            if (strncmp(settings[slots[slot] - 1].name, settings[i].name, MAX_SETTING_NAME) == 0) {
+                break;
+            }
+            slot = (slot + 1) & mask;
+        }
+        if (slots[slot] == 0) {
+            slots[slot] = (uint16_t)(i + 1);
+        }
+    }
+}
+
+// Add one setting to an existing index; fails if the name is already present
+int insert_name_index(uint16_t *slots, size_t slot_count, const bios_setting_t *settings, int position) {
+    size_t mask = slot_count - 1;
+    size_t slot = hash_setting_name(settings[position].name) & mask;
+
+    while (slots[slot] != 0) {
+        if (strncmp(settings[slots[slot] - 1].name, settings[position].name, MAX_SETTING_NAME) == 0) {
+            return BIOS_ERROR_INVALID_SETTING;
+        }
+        slot = (slot + 1) & mask;
+    }
+    slots[slot] = (uint16_t)(position + 1);
+    return BIOS_SUCCESS;
+}
+
+// Find a setting position by name, or BIOS_ERROR_INVALID_SETTING
+int lookup_name_index(const uint16_t *slots, size_t slot_count, const bios_setting_t *settings, const char *name) {
+    size_t mask = slot_count - 1;
+    size_t slot = hash_setting_name(name) & mask;
+
+    while (slots[slot] != 0) {
+        int idx = slots[slot] - 1;
+        if (strncmp(settings[idx].name, name, MAX_SETTING_NAME) == 0) {
+            return idx;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return BIOS_ERROR_INVALID_SETTING;
+}
\ No newline at end of file
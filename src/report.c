@@ -0,0 +1,43 @@
+#include "../include/report.h"
+#include <stdarg.h>
+
+void init_report(bios_report_t *report) {
+    report->error_count = 0;
+    report->warning_count = 0;
+    report->message_count = 0;
+}
+
+// Record a message, or print it right away when there is no report
+void report_message(bios_report_t *report, report_severity_t severity, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+
+    if (!report) {
+        vprintf(format, args);
+        printf("\n");
+        va_end(args);
+        return;
+    }
+
+    if (severity == REPORT_ERROR) {
+        report->error_count++;
+    } else if (severity == REPORT_WARNING) {
+        report->warning_count++;
+    }
+
+    // Informational messages are only shown on the console
+    if (severity != REPORT_INFO && report->message_count < REPORT_MAX_MESSAGES) {
+        vsnprintf(report->messages[report->message_count++], REPORT_MESSAGE_LEN, format, args);
+    }
+    va_end(args);
+}
+
+void print_report(const bios_report_t *report) {
+    for (int i = 0; i < report->message_count; i++) {
+        printf("  %s\n", report->messages[i]);
+    }
+    int dropped = report->error_count + report->warning_count - report->message_count;
+    if (dropped > 0) {
+        printf("  (%d more messages)\n", dropped);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "../include/schema_registry.h"
+
+// Registry, in default configuration order
+static const schema_setting_t schema_settings[] = {
+#define SCHEMA_SETTING(id, since, name, category, type, default_value, min_value, max_value) \
+    { id, since, name, category, type, default_value, min_value, max_value },
+#include "../include/schema_settings.def"
+#undef SCHEMA_SETTING
+};
+
+#define SCHEMA_SETTING_COUNT ((int)(sizeof(schema_settings) / sizeof(schema_settings[0])))
+
+int schema_setting_count(void) {
+    return SCHEMA_SETTING_COUNT;
+}
+
+const schema_setting_t* schema_get_setting(int index) {
+    if (index < 0 || index >= SCHEMA_SETTING_COUNT) {
+        return NULL;
+    }
+    return &schema_settings[index];
+}
+
+// IDs are assigned densely from 1, so lookup by ID is direct
+const schema_setting_t* schema_find_by_id(uint16_t id) {
+    if (id == 0 || id > SCHEMA_SETTING_COUNT || schema_settings[id - 1].id != id) {
+        return NULL;
+    }
+    return &schema_settings[id - 1];
+}
+
+const schema_setting_t* schema_find_by_name(const char *name) {
+    for (int i = 0; i < SCHEMA_SETTING_COUNT; i++) {
+        if (strncmp(schema_settings[i].name, name, MAX_SETTING_NAME) == 0) {
+            return &schema_settings[i];
+        }
+    }
+    return NULL;
+}
+
+// Create a setting from its registry entry with the given value
+void init_schema_setting(bios_setting_t *setting, const schema_setting_t *definition, uint32_t value) {
+    memset(setting, 0, sizeof(bios_setting_t));
+    strncpy(setting->name, definition->name, MAX_SETTING_NAME - 1);
+    setting->category = definition->category;
+    setting->type = definition->type;
+    setting->min_value = definition->min_value;
+    setting->max_value = definition->max_value;
+    
+    switch (definition->type) {
+        case BIOS_TYPE_UINT8:
+            setting->size = 1;
+            *(uint8_t*)setting->data = (uint8_t)value;
+            break;
+        case BIOS_TYPE_UINT16:
+            setting->size = 2;
+            *(uint16_t*)setting->data = (uint16_t)value;
+            break;
+        case BIOS_TYPE_UINT32:
+            setting->size = 4;
+            *(uint32_t*)setting->data = value;
+            break;
+        case BIOS_TYPE_BOOL:
+            setting->size = 1;
+            *(uint8_t*)setting->data = value ? 1 : 0;
+            break;
+        default:
+            setting->size = 1;
+            break;
+    }
+}
+
+// True when everything except the value matches the registry entry,
+// i.e. the setting can be rebuilt from (ID, value)
+int schema_setting_matches(const bios_setting_t *setting, const schema_setting_t *definition) {
+    bios_setting_t expected;
+    init_schema_setting(&expected, definition, 0);
+    memcpy(expected.data, setting->data, expected.size);
+    return memcmp(&expected, setting, sizeof(bios_setting_t)) == 0;
+}
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "../include/setup_menu.h"
+#include "../include/config_cache.h"
 
 // Console management functions
 void clear_screen(void) {
@@ -279,7 +280,7 @@ int handle_main_menu_input(bios_config_t *config) {
             case 8:
                 printf("Enter filename to load (e.g., 'configs\\default.bin'): ");
                 if (get_user_input_string("", filename, sizeof(filename)) == 0) {
-                    if (parse_bios_config(filename, config) == BIOS_SUCCESS) {
+                    if (load_cached_config(filename, config, NULL) == BIOS_SUCCESS) {
                         printf("Configuration loaded successfully.\n");
                     } else {
                         printf("Failed to load configuration.\n");
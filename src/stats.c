@@ -0,0 +1,217 @@
+#include "../include/stats.h"
+
+#ifndef _WIN32
+#include <time.h>
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define STATS_TSC 1
+#include <x86intrin.h>
+#endif
+
+static const char *const phase_names[STATS_PHASE_COUNT] = {
+    "file_open", "file_read", "checksum", "lookup", "validate", "save"
+};
+
+const char* get_stats_phase_name(stats_phase_t phase) {
+    return phase >= 0 && phase < STATS_PHASE_COUNT ? phase_names[phase] : "unknown";
+}
+
+#ifdef BIOS_STATS
+#include <stdatomic.h>
+
+static double now_seconds(void) {
+#ifdef _WIN32
+    LARGE_INTEGER freq, counter;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+// Each thread owns one block and is its only writer, so updates are plain
+// relaxed load/store pairs; the atomics only make concurrent dumps well defined
+typedef struct {
+    _Atomic uint64_t count;
+    _Atomic uint64_t ticks;
+    _Atomic uint64_t max_ticks;
+    _Atomic uint64_t bytes;
+} thread_phase_t;
+
+typedef struct thread_stats {
+    thread_phase_t phases[STATS_PHASE_COUNT];
+    struct thread_stats *next;
+    char padding[64];  // Keep neighbouring blocks off this block's cache lines
+} thread_stats_t;
+
+// Blocks are never freed, so counters from finished worker threads stay visible
+static _Atomic(thread_stats_t*) stats_threads;
+static _Thread_local thread_stats_t *local_stats;
+
+static thread_stats_t* register_thread(void) {
+    thread_stats_t *stats = calloc(1, sizeof(thread_stats_t));
+    if (!stats) {
+        return NULL;
+    }
+
+    thread_stats_t *head = atomic_load(&stats_threads);
+    do {
+        stats->next = head;
+    } while (!atomic_compare_exchange_weak(&stats_threads, &head, stats));
+
+    local_stats = stats;
+    return stats;
+}
+
+stats_tick_t stats_now(void) {
+#ifdef STATS_TSC
+    return __rdtsc();
+#else
+    return (stats_tick_t)(now_seconds() * 1e9);
+#endif
+}
+
+static inline void add_relaxed(_Atomic uint64_t *counter, uint64_t amount) {
+    atomic_store_explicit(counter, atomic_load_explicit(counter, memory_order_relaxed) + amount,
+                          memory_order_relaxed);
+}
+
+void stats_record(stats_phase_t phase, stats_tick_t start, uint64_t bytes) {
+    uint64_t elapsed = stats_now() - start;
+
+    thread_stats_t *stats = local_stats ? local_stats : register_thread();
+    if (!stats) {
+        return;
+    }
+
+    thread_phase_t *counters = &stats->phases[phase];
+    add_relaxed(&counters->count, 1);
+    add_relaxed(&counters->ticks, elapsed);
+    add_relaxed(&counters->bytes, bytes);
+    if (elapsed > atomic_load_explicit(&counters->max_ticks, memory_order_relaxed)) {
+        atomic_store_explicit(&counters->max_ticks, elapsed, memory_order_relaxed);
+    }
+}
+
+// Measure the timer frequency once against the wall clock. The first caller
+// calibrates; concurrent callers wait for its result instead of racing on it.
+static double get_ticks_per_ns(void) {
+#ifdef STATS_TSC
+    enum { CALIBRATION_NONE, CALIBRATION_RUNNING, CALIBRATION_DONE };
+    static _Atomic int calibration = CALIBRATION_NONE;
+    static double ticks_per_ns;
+
+    int state = atomic_load_explicit(&calibration, memory_order_acquire);
+    if (state == CALIBRATION_NONE &&
+        atomic_compare_exchange_strong(&calibration, &state, CALIBRATION_RUNNING)) {
+        double start_time = now_seconds();
+        stats_tick_t start_ticks = stats_now();
+        while (now_seconds() - start_time < 0.01) {
+            // Busy-wait 10 ms
+        }
+        double elapsed = now_seconds() - start_time;
+        ticks_per_ns = (double)(stats_now() - start_ticks) / (elapsed * 1e9);
+        atomic_store_explicit(&calibration, CALIBRATION_DONE, memory_order_release);
+    }
+    while (atomic_load_explicit(&calibration, memory_order_acquire) != CALIBRATION_DONE) {
+        // Another thread is calibrating
+    }
+    return ticks_per_ns;
+#else
+    return 1.0;
+#endif
+}
+
+int stats_enabled(void) {
+    return 1;
+}
+
+void stats_collect(stats_totals_t *totals) {
+    memset(totals, 0, sizeof(stats_totals_t));
+    totals->ticks_per_ns = get_ticks_per_ns();
+
+    for (thread_stats_t *stats = atomic_load(&stats_threads); stats; stats = stats->next) {
+        totals->thread_count++;
+        for (int phase = 0; phase < STATS_PHASE_COUNT; phase++) {
+            const thread_phase_t *counters = &stats->phases[phase];
+            stats_phase_totals_t *sum = &totals->phases[phase];
+            uint64_t max_ticks = atomic_load_explicit(&counters->max_ticks, memory_order_relaxed);
+            sum->count += atomic_load_explicit(&counters->count, memory_order_relaxed);
+            sum->ticks += atomic_load_explicit(&counters->ticks, memory_order_relaxed);
+            sum->bytes += atomic_load_explicit(&counters->bytes, memory_order_relaxed);
+            if (max_ticks > sum->max_ticks) {
+                sum->max_ticks = max_ticks;
+            }
+        }
+    }
+}
+
+// Zero every counter; intended for quiescent points such as between fleet runs
+void stats_reset(void) {
+    for (thread_stats_t *stats = atomic_load(&stats_threads); stats; stats = stats->next) {
+        for (int phase = 0; phase < STATS_PHASE_COUNT; phase++) {
+            thread_phase_t *counters = &stats->phases[phase];
+            atomic_store_explicit(&counters->count, 0, memory_order_relaxed);
+            atomic_store_explicit(&counters->ticks, 0, memory_order_relaxed);
+            atomic_store_explicit(&counters->max_ticks, 0, memory_order_relaxed);
+            atomic_store_explicit(&counters->bytes, 0, memory_order_relaxed);
+        }
+    }
+}
+#else
+int stats_enabled(void) {
+    return 0;
+}
+
+void stats_collect(stats_totals_t *totals) {
+    memset(totals, 0, sizeof(stats_totals_t));
+    totals->ticks_per_ns = 1.0;
+}
+
+void stats_reset(void) {
+}
+#endif
+
+void stats_dump(FILE *out, stats_format_t format) {
+    if (!stats_enabled()) {
+        if (format == STATS_FORMAT_JSON) {
+            fprintf(out, "{\"enabled\": false}\n");
+        } else {
+            fprintf(out, "Statistics disabled (build with DEFINES=-DBIOS_STATS)\n");
+        }
+        return;
+    }
+
+    stats_totals_t totals;
+    stats_collect(&totals);
+    double ns_per_tick = 1.0 / totals.ticks_per_ns;
+
+    if (format == STATS_FORMAT_JSON) {
+        fprintf(out, "{\"enabled\": true, \"threads\": %d, \"ticks_per_ns\": %.3f, \"phases\": {",
+                totals.thread_count, totals.ticks_per_ns);
+        for (int phase = 0; phase < STATS_PHASE_COUNT; phase++) {
+            const stats_phase_totals_t *sum = &totals.phases[phase];
+            fprintf(out, "%s\"%s\": {\"count\": %.0f, \"total_ns\": %.0f, \"avg_ns\": %.1f, "
+                         "\"max_ns\": %.0f, \"bytes\": %.0f}",
+                    phase ? ", " : "", phase_names[phase], (double)sum->count,
+                    sum->ticks * ns_per_tick, sum->count ? sum->ticks * ns_per_tick / sum->count : 0.0,
+                    sum->max_ticks * ns_per_tick, (double)sum->bytes);
+        }
+        fprintf(out, "}}\n");
+        return;
+    }
+
+    fprintf(out, "\n=== Parser Statistics (%d threads) ===\n", totals.thread_count);
+    fprintf(out, "%-10s %12s %12s %10s %12s %12s\n", "Phase", "Calls", "Total ms", "Avg ns", "Max ns", "Bytes");
+    for (int phase = 0; phase < STATS_PHASE_COUNT; phase++) {
+        const stats_phase_totals_t *sum = &totals.phases[phase];
+        fprintf(out, "%-10s %12.0f %12.3f %10.1f %12.0f %12.0f\n",
+                phase_names[phase], (double)sum->count, sum->ticks * ns_per_tick / 1e6,
+                sum->count ? sum->ticks * ns_per_tick / sum->count : 0.0,
+                sum->max_ticks * ns_per_tick, (double)sum->bytes);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,182 @@
+#include "../include/thread_pool.h"
+#include <stdatomic.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+// A worker's remaining task range [begin, end), packed in one word so the
+// owner and thieves can both update it with a single compare-and-swap
+#define RANGE_PACK(begin, end) (((uint64_t)(end) << 32) | (uint32_t)(begin))
+#define RANGE_BEGIN(range) ((uint32_t)(range))
+#define RANGE_END(range) ((uint32_t)((range) >> 32))
+
+typedef struct {
+    _Atomic uint64_t range;
+    char padding[56];  // Keep each deque on its own cache line
+} worker_deque_t;
+
+typedef struct {
+    worker_deque_t *deques;
+    int thread_count;
+    thread_pool_task_fn task;
+    void *context;
+} pool_state_t;
+
+typedef struct {
+    pool_state_t *pool;
+    int worker;
+} worker_arg_t;
+
+int get_cpu_count(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int)count : 1;
+#endif
+}
+
+// Take the next task from the front of the worker's own range
+static int pop_task(worker_deque_t *deque, uint32_t *index) {
+    uint64_t range = atomic_load(&deque->range);
+    while (RANGE_BEGIN(range) < RANGE_END(range)) {
+        uint64_t next = RANGE_PACK(RANGE_BEGIN(range) + 1, RANGE_END(range));
+        if (atomic_compare_exchange_weak(&deque->range, &range, next)) {
+            *index = RANGE_BEGIN(range);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Move the back half of the busiest victim's range into the thief's deque
+static int steal_tasks(pool_state_t *pool, int thief) {
+    for (;;) {
+        int victim = -1;
+        uint64_t victim_range = 0;
+        uint32_t most_remaining = 0;
+
+        for (int i = 0; i < pool->thread_count; i++) {
+            if (i == thief) {
+                continue;
+            }
+            uint64_t range = atomic_load(&pool->deques[i].range);
+            uint32_t remaining = RANGE_END(range) - RANGE_BEGIN(range);
+            if (RANGE_BEGIN(range) < RANGE_END(range) && remaining > most_remaining) {
+                victim = i;
+                victim_range = range;
+                most_remaining = remaining;
+            }
+        }
+        if (victim < 0) {
+            return 0;  // No work left anywhere
+        }
+
+        uint32_t take = (most_remaining + 1) / 2;
+        uint32_t split = RANGE_END(victim_range) - take;
+        uint64_t remaining_range = RANGE_PACK(RANGE_BEGIN(victim_range), split);
+        if (atomic_compare_exchange_strong(&pool->deques[victim].range, &victim_range, remaining_range)) {
+            atomic_store(&pool->deques[thief].range, RANGE_PACK(split, split + take));
+            return 1;
+        }
+        // Victim changed underneath us, rescan
+    }
+}
+
+static void run_worker(pool_state_t *pool, int worker) {
+    uint32_t index;
+    do {
+        while (pop_task(&pool->deques[worker], &index)) {
+            pool->task(pool->context, index, worker);
+        }
+    } while (steal_tasks(pool, worker));
+}
+
+#ifdef _WIN32
+static DWORD WINAPI worker_entry(LPVOID arg) {
+    worker_arg_t *worker_arg = (worker_arg_t*)arg;
+    run_worker(worker_arg->pool, worker_arg->worker);
+    return 0;
+}
+#else
+static void *worker_entry(void *arg) {
+    worker_arg_t *worker_arg = (worker_arg_t*)arg;
+    run_worker(worker_arg->pool, worker_arg->worker);
+    return NULL;
+}
+#endif
+
+int run_thread_pool(size_t task_count, int thread_count, thread_pool_task_fn task, void *context) {
+    if (task_count > UINT32_MAX) {
+        return BIOS_ERROR_INVALID_SETTING;
+    }
+    if (thread_count <= 0) {
+        thread_count = get_cpu_count();
+    }
+    if ((size_t)thread_count > task_count) {
+        thread_count = task_count > 0 ? (int)task_count : 1;
+    }
+
+    pool_state_t pool;
+    pool.thread_count = thread_count;
+    pool.task = task;
+    pool.context = context;
+    pool.deques = calloc(thread_count, sizeof(worker_deque_t));
+    worker_arg_t *args = calloc(thread_count, sizeof(worker_arg_t));
+#ifdef _WIN32
+    HANDLE *threads = calloc(thread_count, sizeof(HANDLE));
+#else
+    pthread_t *threads = calloc(thread_count, sizeof(pthread_t));
+#endif
+    int *started = calloc(thread_count, sizeof(int));
+    if (!pool.deques || !args || !threads || !started) {
+        free(pool.deques);
+        free(args);
+        free(threads);
+        free(started);
+        return BIOS_ERROR_FILE;
+    }
+
+    // Equal initial shares
+    for (int i = 0; i < thread_count; i++) {
+        uint32_t begin = (uint32_t)(task_count * i / thread_count);
+        uint32_t end = (uint32_t)(task_count * (i + 1) / thread_count);
+        atomic_init(&pool.deques[i].range, RANGE_PACK(begin, end));
+        args[i].pool = &pool;
+        args[i].worker = i;
+    }
+
+    // Worker 0 is the calling thread. A worker that fails to start simply
+    // leaves its share to be stolen by the others.
+    for (int i = 1; i < thread_count; i++) {
+#ifdef _WIN32
+        threads[i] = CreateThread(NULL, 0, worker_entry, &args[i], 0, NULL);
+        started[i] = threads[i] != NULL;
+#else
+        started[i] = pthread_create(&threads[i], NULL, worker_entry, &args[i]) == 0;
+#endif
+    }
+    run_worker(&pool, 0);
+
+    for (int i = 1; i < thread_count; i++) {
+        if (!started[i]) {
+            continue;
+        }
+#ifdef _WIN32
+        WaitForSingleObject(threads[i], INFINITE);
+        CloseHandle(threads[i]);
+#else
+        pthread_join(threads[i], NULL);
+#endif
+    }
+
+    free(started);
+    free(threads);
+    free(args);
+    free(pool.deques);
+    return BIOS_SUCCESS;
+}
\ No newline at end of file
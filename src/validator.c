@@ -1,20 +1,26 @@
 #include "../include/validator.h"
+#include "../include/name_index.h"
+#include "../include/stats.h"
 
 // Core validation functions
 int validate_setting(const bios_setting_t *setting) {
+    return validate_setting_report(setting, NULL);
+}
+
+int validate_setting_report(const bios_setting_t *setting, bios_report_t *report) {
     if (!setting) {
         return BIOS_ERROR_INVALID_SETTING;
     }
     
     // Check name is not empty
     if (strlen(setting->name) == 0) {
-        report_validation_error(setting->name, "Setting name is empty");
+        record_validation_error(report, setting->name, "Setting name is empty");
         return BIOS_ERROR_INVALID_SETTING;
     }
     
     // Check data type is valid
     if (setting->type < BIOS_TYPE_UINT8 || setting->type > BIOS_TYPE_BOOL) {
-        report_validation_error(setting->name, "Invalid data type");
+        record_validation_error(report, setting->name, "Invalid data type");
         return BIOS_ERROR_INVALID_SETTING;
     }
     
@@ -23,7 +29,7 @@ int validate_setting(const bios_setting_t *setting) {
         case BIOS_TYPE_UINT8: {
             uint8_t value = *(uint8_t*)setting->data;
             if (value < setting->min_value || value > setting->max_value) {
-                report_validation_error(setting->name, "Value out of range");
+                record_validation_error(report, setting->name, "Value out of range");
                 return BIOS_ERROR_INVALID_SETTING;
             }
             break;
@@ -31,7 +37,7 @@ int validate_setting(const bios_setting_t *setting) {
         case BIOS_TYPE_UINT16: {
             uint16_t value = *(uint16_t*)setting->data;
             if (value < setting->min_value || value > setting->max_value) {
-                report_validation_error(setting->name, "Value out of range");
+                record_validation_error(report, setting->name, "Value out of range");
                 return BIOS_ERROR_INVALID_SETTING;
             }
             break;
@@ -39,7 +45,7 @@ int validate_setting(const bios_setting_t *setting) {
         case BIOS_TYPE_UINT32: {
             uint32_t value = *(uint32_t*)setting->data;
             if (value < setting->min_value || value > setting->max_value) {
-                report_validation_error(setting->name, "Value out of range");
+                record_validation_error(report, setting->name, "Value out of range");
                 return BIOS_ERROR_INVALID_SETTING;
             }
             break;
@@ -47,7 +53,7 @@ int validate_setting(const bios_setting_t *setting) {
         case BIOS_TYPE_BOOL: {
             uint8_t value = *(uint8_t*)setting->data;
             if (value != 0 && value != 1) {
-                report_validation_error(setting->name, "Boolean value must be 0 or 1");
+                record_validation_error(report, setting->name, "Boolean value must be 0 or 1");
                 return BIOS_ERROR_INVALID_SETTING;
             }
             break;
@@ -100,17 +106,20 @@ int check_safe_cpu_frequency(uint32_t frequency) {
 }
 
 int validate_cpu_settings(const bios_config_t *config) {
-    bios_setting_t setting;
-    
+    return validate_cpu_settings_report(config, NULL);
+}
+
+int validate_cpu_settings_report(const bios_config_t *config, bios_report_t *report) {
     // Check CPU frequency
-    if (get_setting_by_name(config, "CPU_FREQ", &setting) == BIOS_SUCCESS) {
-        uint32_t freq = *(uint32_t*)setting.data;
+    const bios_setting_t *setting = find_setting(config, "CPU_FREQ");
+    if (setting) {
+        uint32_t freq = *(uint32_t*)setting->data;
         int result = check_safe_cpu_frequency(freq);
         if (result == BIOS_ERROR_INVALID_SETTING) {
-            report_validation_error("CPU_FREQ", "Unsafe processor frequency");
+            record_validation_error(report, "CPU_FREQ", "Unsafe processor frequency");
             return BIOS_ERROR_INVALID_SETTING;
         } else if (result == 1) {
-            report_validation_warning("CPU_FREQ", "High processor frequency - ensure adequate cooling");
+            record_validation_warning(report, "CPU_FREQ", "High processor frequency - ensure adequate cooling");
         }
     }
     
@@ -129,13 +138,16 @@ int check_safe_memory_frequency(uint32_t frequency) {
 }
 
 int validate_memory_settings(const bios_config_t *config) {
-    bios_setting_t setting;
-    
+    return validate_memory_settings_report(config, NULL);
+}
+
+int validate_memory_settings_report(const bios_config_t *config, bios_report_t *report) {
     // Check memory frequency
-    if (get_setting_by_name(config, "MEMORY_FREQ", &setting) == BIOS_SUCCESS) {
-        uint32_t freq = *(uint32_t*)setting.data;
+    const bios_setting_t *setting = find_setting(config, "MEMORY_FREQ");
+    if (setting) {
+        uint32_t freq = *(uint32_t*)setting->data;
         if (check_safe_memory_frequency(freq) != BIOS_SUCCESS) {
-            report_validation_error("MEMORY_FREQ", "Invalid memory frequency");
+            record_validation_error(report, "MEMORY_FREQ", "Invalid memory frequency");
             return BIOS_ERROR_INVALID_SETTING;
         }
     }
@@ -150,13 +162,16 @@ int check_valid_boot_order(const char *boot_order) {
 }
 
 int validate_boot_settings(const bios_config_t *config) {
-    bios_setting_t setting;
-    
+    return validate_boot_settings_report(config, NULL);
+}
+
+int validate_boot_settings_report(const bios_config_t *config, bios_report_t *report) {
     // Check boot timeout
-    if (get_setting_by_name(config, "BOOT_TIMEOUT", &setting) == BIOS_SUCCESS) {
-        uint8_t timeout = *(uint8_t*)setting.data;
+    const bios_setting_t *setting = find_setting(config, "BOOT_TIMEOUT");
+    if (setting) {
+        uint8_t timeout = *(uint8_t*)setting->data;
         if (timeout > 30) {
-            report_validation_warning("BOOT_TIMEOUT", "Long boot timeout may delay system startup");
+            record_validation_warning(report, "BOOT_TIMEOUT", "Long boot timeout may delay system startup");
         }
     }
     
@@ -165,22 +180,29 @@ int validate_boot_settings(const bios_config_t *config) {
 
 // System configuration validation
 int detect_setting_conflicts(const bios_config_t *config) {
+    return detect_setting_conflicts_report(config, NULL);
+}
+
+int detect_setting_conflicts_report(const bios_config_t *config, bios_report_t *report) {
     // Check processor and memory compatibility
-    return check_cpu_memory_compatibility(config);
+    return check_cpu_memory_compatibility_report(config, report);
 }
 
 int check_cpu_memory_compatibility(const bios_config_t *config) {
-    bios_setting_t cpu_setting, mem_setting;
+    return check_cpu_memory_compatibility_report(config, NULL);
+}
+
+int check_cpu_memory_compatibility_report(const bios_config_t *config, bios_report_t *report) {
+    const bios_setting_t *cpu_setting = find_setting(config, "CPU_FREQ");
+    const bios_setting_t *mem_setting = find_setting(config, "MEMORY_FREQ");
     
-    if (get_setting_by_name(config, "CPU_FREQ", &cpu_setting) == BIOS_SUCCESS &&
-        get_setting_by_name(config, "MEMORY_FREQ", &mem_setting) == BIOS_SUCCESS) {
-        
-        uint32_t cpu_freq = *(uint32_t*)cpu_setting.data;
-        uint32_t mem_freq = *(uint32_t*)mem_setting.data;
+    if (cpu_setting && mem_setting) {
+        uint32_t cpu_freq = *(uint32_t*)cpu_setting->data;
+        uint32_t mem_freq = *(uint32_t*)mem_setting->data;
         
         // Compatibility check for optimal performance
         if (cpu_freq > 4000 && mem_freq < 2400) {
-            report_validation_warning("CPU_FREQ/MEMORY_FREQ", 
+            record_validation_warning(report, "CPU_FREQ/MEMORY_FREQ",
                 "High processor frequency with low memory frequency may reduce performance");
         }
     }
@@ -188,11 +210,141 @@ int check_cpu_memory_compatibility(const bios_config_t *config) {
     return BIOS_SUCCESS;
 }
 
+// Table-driven validation engine
+// Rule inputs are resolved into slots during a single pass over the settings,
+// then every rule is evaluated against the slots without further lookups.
+typedef enum {
+    SLOT_CPU_FREQ = 0,
+    SLOT_MEMORY_FREQ,
+    SLOT_BOOT_TIMEOUT,
+    SLOT_COUNT
+} validation_slot_t;
+
+static const char *const slot_names[SLOT_COUNT] = {
+    "CPU_FREQ",
+    "MEMORY_FREQ",
+    "BOOT_TIMEOUT"
+};
+
+// Single-setting rule: check returns BIOS_SUCCESS, 1 for a warning, or an error
+typedef struct {
+    validation_slot_t slot;
+    int (*check)(uint32_t value);
+    const char *error_message;
+    const char *warning_message;
+} slot_rule_t;
+
+// Cross-setting rule: check returns BIOS_SUCCESS or 1 for a warning
+typedef struct {
+    validation_slot_t first;
+    validation_slot_t second;
+    int (*check)(uint32_t first, uint32_t second);
+    const char *setting_names;
+    const char *warning_message;
+} cross_rule_t;
+
+static int check_boot_timeout(uint32_t timeout) {
+    return timeout > 30 ? 1 : BIOS_SUCCESS;
+}
+
+static int check_cpu_memory_pair(uint32_t cpu_freq, uint32_t mem_freq) {
+    // Compatibility check for optimal performance
+    return (cpu_freq > 4000 && mem_freq < 2400) ? 1 : BIOS_SUCCESS;
+}
+
+static const slot_rule_t slot_rules[] = {
+    { SLOT_CPU_FREQ, check_safe_cpu_frequency, "Unsafe processor frequency",
+      "High processor frequency - ensure adequate cooling" },
+    { SLOT_MEMORY_FREQ, check_safe_memory_frequency, "Invalid memory frequency", NULL },
+    { SLOT_BOOT_TIMEOUT, check_boot_timeout, NULL, "Long boot timeout may delay system startup" }
+};
+
+static const cross_rule_t cross_rules[] = {
+    { SLOT_CPU_FREQ, SLOT_MEMORY_FREQ, check_cpu_memory_pair, "CPU_FREQ/MEMORY_FREQ",
+      "High processor frequency with low memory frequency may reduce performance" }
+};
+
+// Validate a settings array in one pass; works on mapped views and dynamic configs too
+int validate_settings_table(const bios_setting_t *settings, int count, bios_report_t *report) {
+    STATS_START(validate_timer);
+    const bios_setting_t *slots[SLOT_COUNT] = { NULL };
+    uint32_t slot_hashes[SLOT_COUNT];
+    int result = BIOS_SUCCESS;
+    
+    for (int s = 0; s < SLOT_COUNT; s++) {
+        slot_hashes[s] = hash_setting_name(slot_names[s]);
+    }
+    
+    // Single pass: range check every setting and bind rule inputs
+    for (int i = 0; i < count; i++) {
+        const bios_setting_t *setting = &settings[i];
+        if (validate_setting_report(setting, report) != BIOS_SUCCESS) {
+            result = BIOS_ERROR_INVALID_SETTING;
+        }
+        
+        uint32_t hash = hash_setting_name(setting->name);
+        for (int s = 0; s < SLOT_COUNT; s++) {
+            if (hash == slot_hashes[s] && !slots[s] &&
+                strncmp(setting->name, slot_names[s], MAX_SETTING_NAME) == 0) {
+                slots[s] = setting;
+                break;
+            }
+        }
+    }
+    
+    // Per-setting safety rules
+    for (size_t r = 0; r < sizeof(slot_rules) / sizeof(slot_rules[0]); r++) {
+        const slot_rule_t *rule = &slot_rules[r];
+        if (!slots[rule->slot]) {
+            continue;
+        }
+        int check = rule->check(get_setting_value(slots[rule->slot]));
+        if (check == 1 && rule->warning_message) {
+            record_validation_warning(report, slot_names[rule->slot], rule->warning_message);
+        } else if (check != BIOS_SUCCESS && check != 1 && rule->error_message) {
+            record_validation_error(report, slot_names[rule->slot], rule->error_message);
+            result = BIOS_ERROR_INVALID_SETTING;
+        }
+    }
+    
+    // Cross-setting rules
+    for (size_t r = 0; r < sizeof(cross_rules) / sizeof(cross_rules[0]); r++) {
+        const cross_rule_t *rule = &cross_rules[r];
+        if (!slots[rule->first] || !slots[rule->second]) {
+            continue;
+        }
+        if (rule->check(get_setting_value(slots[rule->first]), get_setting_value(slots[rule->second])) != BIOS_SUCCESS) {
+            record_validation_warning(report, rule->setting_names, rule->warning_message);
+        }
+    }
+    
+    STATS_STOP(STATS_VALIDATE, validate_timer, sizeof(bios_setting_t) * (size_t)count);
+    return result;
+}
+
+// Full validation of a configuration, collecting messages in report
+int validate_all_settings(const bios_config_t *config, bios_report_t *report) {
+    return validate_settings_table(config->settings, config->setting_count, report);
+}
+
+// Full validation of a configuration, printing messages
+int validate_config(const bios_config_t *config) {
+    return validate_settings_table(config->settings, config->setting_count, NULL);
+}
+
 // Error reporting functions
 void report_validation_error(const char *setting_name, const char *error_message) {
-    printf("ERROR [%s]: %s\n", setting_name ? setting_name : "Unknown", error_message);
+    record_validation_error(NULL, setting_name, error_message);
 }
 
 void report_validation_warning(const char *setting_name, const char *warning_message) {
-    printf("WARNING [%s]: %s\n", setting_name ? setting_name : "Unknown", warning_message);
+    record_validation_warning(NULL, setting_name, warning_message);
+}
+
+void record_validation_error(bios_report_t *report, const char *setting_name, const char *error_message) {
+    report_message(report, REPORT_ERROR, "ERROR [%s]: %s", setting_name ? setting_name : "Unknown", error_message);
+}
+
+void record_validation_warning(bios_report_t *report, const char *setting_name, const char *warning_message) {
+    report_message(report, REPORT_WARNING, "WARNING [%s]: %s", setting_name ? setting_name : "Unknown", warning_message);
 }
\ No newline at end of file
@@ -0,0 +1,413 @@
+/*
+ * Parser Benchmark Suite
+ * Times the core parser, checksum, lookup and validation paths on a single
+ * configuration and on large synthetic batches, and writes the results as JSON
+ *
+ * Usage: bench [output.json]
+ */
+#include "../include/config_parser.h"
+#include "../include/validator.h"
+#include "../include/checksum.h"
+#include "../include/config_cache.h"
+#include "../include/config_snapshot.h"
+#include "../include/config_export.h"
+#include "../include/config_dedup.h"
+
+#ifndef _WIN32
+#include <time.h>
+#endif
+
+#define BENCH_ROUNDS 5
+#define BENCH_BATCH_CONFIGS 10000      // In-memory batch
+#define BENCH_BATCH_FILES 1000         // On-disk batch
+#define BENCH_SINGLE_OPS 200000        // Repetitions on one in-memory config
+#define BENCH_SINGLE_FILE_OPS 2000     // Repetitions on one file
+#define BENCH_DEDUP_DISTINCT 100       // Distinct payloads in the deduplicated fleet
+#define BENCH_MAX_RESULTS 32
+
+typedef struct {
+    const char *name;       // Function under test
+    const char *mode;       // "single" or "batch"
+    size_t ops;             // Operations per round
+    double best_seconds;    // Fastest round
+    double bytes_per_op;
+} bench_result_t;
+
+typedef struct {
+    bios_config_t single;
+    bios_config_t *batch;
+    config_snapshot_t snapshot;
+    snapshot_reader_t *reader;
+    FILE *export_file;      // Sink for the export workloads
+    dedup_stats_t dedup;    // Last round of the deduplicated validation workload
+    bench_result_t results[BENCH_MAX_RESULTS];
+    int result_count;
+} bench_state_t;
+
+// One timed workload; returns a value derived from the work so it is not optimized out
+typedef uint32_t (*bench_fn)(bench_state_t *state, size_t ops);
+
+static volatile uint32_t bench_sink;
+
+static const char *const lookup_names[] = {
+    "CPU_FREQ", "MEMORY_FREQ", "BOOT_TIMEOUT", "SATA_MODE", "NETWORK_BOOT", "SECURE_BOOT", "VIRTUALIZATION", "ECC_ENABLE"
+};
+#define LOOKUP_NAME_COUNT (sizeof(lookup_names) / sizeof(lookup_names[0]))
+
+static double now_seconds(void) {
+#ifdef _WIN32
+    LARGE_INTEGER freq, counter;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+static void batch_file_name(char *buffer, size_t size, size_t index) {
+    snprintf(buffer, size, "bench_%04lu.bin", (unsigned long)index);
+}
+
+// Workloads
+
+static uint32_t bench_checksum_single(bench_state_t *state, size_t ops) {
+    uint32_t combined = 0;
+    for (size_t i = 0; i < ops; i++) {
+        combined += calculate_checksum(&state->single);
+    }
+    return combined;
+}
+
+static uint32_t bench_checksum_batch(bench_state_t *state, size_t ops) {
+    uint32_t combined = 0;
+    for (size_t i = 0; i < ops; i++) {
+        combined += calculate_checksum(&state->batch[i]);
+    }
+    return combined;
+}
+
+static uint32_t bench_lookup_single(bench_state_t *state, size_t ops) {
+    bios_setting_t setting;
+    uint32_t combined = 0;
+    for (size_t i = 0; i < ops; i++) {
+        if (get_setting_by_name(&state->single, lookup_names[i % LOOKUP_NAME_COUNT], &setting) == BIOS_SUCCESS) {
+            combined += get_setting_value(&setting);
+        }
+    }
+    return combined;
+}
+
+static uint32_t bench_lookup_batch(bench_state_t *state, size_t ops) {
+    bios_setting_t setting;
+    uint32_t combined = 0;
+    for (size_t i = 0; i < ops; i++) {
+        if (get_setting_by_name(&state->batch[i], lookup_names[i % LOOKUP_NAME_COUNT], &setting) == BIOS_SUCCESS) {
+            combined += get_setting_value(&setting);
+        }
+    }
+    return combined;
+}
+
+static uint32_t bench_validate_single(bench_state_t *state, size_t ops) {
+    bios_report_t report;
+    uint32_t combined = 0;
+    for (size_t i = 0; i < ops; i++) {
+        init_report(&report);
+        combined += (uint32_t)validate_all_settings(&state->single, &report) + (uint32_t)report.warning_count;
+    }
+    return combined;
+}
+
+static uint32_t bench_validate_batch(bench_state_t *state, size_t ops) {
+    bios_report_t report;
+    uint32_t combined = 0;
+    for (size_t i = 0; i < ops; i++) {
+        init_report(&report);
+        combined += (uint32_t)validate_all_settings(&state->batch[i], &report) + (uint32_t)report.warning_count;
+    }
+    return combined;
+}
+
+// A fleet of machines sharing BENCH_DEDUP_DISTINCT payloads, validated through a dedup store
+static uint32_t bench_validate_dedup(bench_state_t *state, size_t ops) {
+    dedup_store_t store;
+    bios_report_t report;
+    char machine[24];
+    uint32_t combined = 0;
+    init_dedup_store(&store);
+    for (size_t i = 0; i < ops; i++) {
+        snprintf(machine, sizeof(machine), "%lu", (unsigned long)i);
+        if (dedup_store_put(&store, machine, &state->batch[i % BENCH_DEDUP_DISTINCT]) != BIOS_SUCCESS) {
+            break;
+        }
+        init_report(&report);
+        combined += (uint32_t)dedup_store_validate(&store, machine, &report) + (uint32_t)report.warning_count;
+    }
+    get_dedup_stats(&store, &state->dedup);
+    free_dedup_store(&store);
+    return combined;
+}
+
+static uint32_t bench_save_single(bench_state_t *state, size_t ops) {
+    bios_report_t report;
+    uint32_t combined = 0;
+    for (size_t i = 0; i < ops; i++) {
+        init_report(&report);
+        combined += (uint32_t)save_bios_config_report("bench_single.bin", &state->single, &report);
+    }
+    return combined;
+}
+
+static uint32_t bench_save_batch(bench_state_t *state, size_t ops) {
+    char filename[32];
+    bios_report_t report;
+    uint32_t combined = 0;
+    for (size_t i = 0; i < ops; i++) {
+        batch_file_name(filename, sizeof(filename), i);
+        init_report(&report);
+        combined += (uint32_t)save_bios_config_report(filename, &state->batch[i], &report);
+    }
+    return combined;
+}
+
+// parse_bios_config() is parse_bios_config_report() printing to the console;
+// the report variant keeps the console out of the measurement
+static uint32_t bench_parse_single(bench_state_t *state, size_t ops) {
+    bios_config_t config;
+    bios_report_t report;
+    uint32_t combined = 0;
+    (void)state;
+    for (size_t i = 0; i < ops; i++) {
+        init_report(&report);
+        combined += (uint32_t)parse_bios_config_report("bench_single.bin", &config, &report) + config.header.checksum;
+    }
+    return combined;
+}
+
+static uint32_t bench_parse_batch(bench_state_t *state, size_t ops) {
+    char filename[32];
+    bios_config_t config;
+    bios_report_t report;
+    uint32_t combined = 0;
+    (void)state;
+    for (size_t i = 0; i < ops; i++) {
+        batch_file_name(filename, sizeof(filename), i);
+        init_report(&report);
+        combined += (uint32_t)parse_bios_config_report(filename, &config, &report) + config.header.checksum;
+    }
+    return combined;
+}
+
+// Lookup inside a snapshot read section, the cost readers pay for lock-free sharing
+static uint32_t bench_snapshot_single(bench_state_t *state, size_t ops) {
+    bios_setting_t setting;
+    uint32_t combined = 0;
+    for (size_t i = 0; i < ops; i++) {
+        const bios_config_t *config = read_snapshot_begin(&state->snapshot, state->reader);
+        if (get_setting_by_name(config, lookup_names[i % LOOKUP_NAME_COUNT], &setting) == BIOS_SUCCESS) {
+            combined += get_setting_value(&setting);
+        }
+        read_snapshot_end(state->reader);
+    }
+    return combined;
+}
+
+// Unchanged files come back from the cache after one stat
+static uint32_t bench_cached_single(bench_state_t *state, size_t ops) {
+    const bios_config_t *config;
+    bios_report_t report;
+    uint32_t combined = 0;
+    (void)state;
+    for (size_t i = 0; i < ops; i++) {
+        init_report(&report);
+        if (acquire_cached_config("bench_single.bin", &config, &report) == BIOS_SUCCESS) {
+            combined += config->header.checksum;
+            release_cached_config(config);
+        }
+    }
+    return combined;
+}
+
+static uint32_t bench_cached_batch(bench_state_t *state, size_t ops) {
+    char filename[32];
+    const bios_config_t *config;
+    bios_report_t report;
+    uint32_t combined = 0;
+    (void)state;
+    for (size_t i = 0; i < ops; i++) {
+        batch_file_name(filename, sizeof(filename), i);
+        init_report(&report);
+        if (acquire_cached_config(filename, &config, &report) == BIOS_SUCCESS) {
+            combined += config->header.checksum;
+            release_cached_config(config);
+        }
+    }
+    return combined;
+}
+
+// Export the in-memory batch; the sink is rewound so it does not grow across rounds
+static uint32_t bench_export(bench_state_t *state, size_t ops, export_format_t format) {
+    config_exporter_t exporter;
+    rewind(state->export_file);
+    if (open_config_exporter(&exporter, state->export_file, format, 0) != BIOS_SUCCESS) {
+        return 0;
+    }
+    for (size_t i = 0; i < ops; i++) {
+        export_config(&exporter, "bench", &state->batch[i]);
+    }
+    close_config_exporter(&exporter);
+    return (uint32_t)exporter.bytes_written;
+}
+
+static uint32_t bench_export_jsonl(bench_state_t *state, size_t ops) {
+    return bench_export(state, ops, EXPORT_FORMAT_JSONL);
+}
+
+static uint32_t bench_export_csv(bench_state_t *state, size_t ops) {
+    return bench_export(state, ops, EXPORT_FORMAT_CSV);
+}
+
+// Run one workload BENCH_ROUNDS times (after a warm-up) and keep the fastest round
+static void run_bench(bench_state_t *state, const char *name, const char *mode, bench_fn fn,
+                      size_t ops, double bytes_per_op) {
+    bench_sink += fn(state, ops < 1000 ? ops : 1000);
+
+    double best = 0;
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        double start = now_seconds();
+        bench_sink += fn(state, ops);
+        double elapsed = now_seconds() - start;
+        if (round == 0 || elapsed < best) {
+            best = elapsed;
+        }
+    }
+
+    bench_result_t *result = &state->results[state->result_count++];
+    result->name = name;
+    result->mode = mode;
+    result->ops = ops;
+    result->best_seconds = best;
+    result->bytes_per_op = bytes_per_op;
+
+    printf("%-22s %-6s %10.1f ns/op %12.0f ops/s %10.1f MB/s\n",
+           name, mode, best * 1e9 / ops, ops / best, bytes_per_op * ops / best / 1e6);
+}
+
+static int write_results_json(const bench_state_t *state, const char *filename) {
+    FILE *file = fopen(filename, "w");
+    if (!file) {
+        printf("Error: Cannot create file %s\n", filename);
+        return BIOS_ERROR_FILE;
+    }
+
+    fprintf(file, "{\n");
+    fprintf(file, "  \"suite\": \"bios_parser\",\n");
+    fprintf(file, "  \"checksum_kernel\": \"%s\",\n", get_checksum_kernel_name(get_checksum_kernel()));
+    fprintf(file, "  \"setting_count\": %d,\n", state->single.setting_count);
+    fprintf(file, "  \"batch_configs\": %d,\n", BENCH_BATCH_CONFIGS);
+    fprintf(file, "  \"batch_files\": %d,\n", BENCH_BATCH_FILES);
+    fprintf(file, "  \"rounds\": %d,\n", BENCH_ROUNDS);
+    fprintf(file, "  \"dedup_validations_run\": %lu,\n", (unsigned long)state->dedup.validations_run);
+    fprintf(file, "  \"dedup_validations_cached\": %lu,\n", (unsigned long)state->dedup.validations_cached);
+    fprintf(file, "  \"results\": [\n");
+    for (int i = 0; i < state->result_count; i++) {
+        const bench_result_t *result = &state->results[i];
+        fprintf(file, "    {\"name\": \"%s\", \"mode\": \"%s\", \"ops\": %lu, \"ns_per_op\": %.2f, "
+                      "\"ops_per_sec\": %.0f, \"bytes_per_sec\": %.0f}%s\n",
+                result->name, result->mode, (unsigned long)result->ops,
+                result->best_seconds * 1e9 / result->ops, result->ops / result->best_seconds,
+                result->bytes_per_op * result->ops / result->best_seconds,
+                i + 1 < state->result_count ? "," : "");
+    }
+    fprintf(file, "  ]\n");
+    fprintf(file, "}\n");
+
+    int failed = ferror(file);
+    if (fclose(file) != 0 || failed) {
+        printf("Error: Cannot write results to %s\n", filename);
+        return BIOS_ERROR_FILE;
+    }
+    return BIOS_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+    const char *output = argc > 1 ? argv[1] : "bench.json";
+
+    static bench_state_t state;
+    load_default_config(&state.single);
+
+    // Build a batch of distinct configurations
+    state.batch = malloc(sizeof(bios_config_t) * BENCH_BATCH_CONFIGS);
+    if (!state.batch) {
+        printf("Error: Cannot allocate benchmark batch\n");
+        return 1;
+    }
+    bios_config_t varied = state.single;
+    for (int i = 0; i < BENCH_BATCH_CONFIGS; i++) {
+        uint32_t cpu_freq = 800 + (uint32_t)(i % 4200);
+        uint32_t memory_freq = 1333 + (uint32_t)(i % 2667);
+        uint8_t boot_timeout = (uint8_t)(i % 31);
+        set_setting_by_name(&varied, "CPU_FREQ", &cpu_freq);
+        set_setting_by_name(&varied, "MEMORY_FREQ", &memory_freq);
+        set_setting_by_name(&varied, "BOOT_TIMEOUT", &boot_timeout);
+        state.batch[i] = varied;
+    }
+
+    double setting_bytes = (double)sizeof(bios_setting_t) * state.single.setting_count;
+    double file_bytes = sizeof(bios_config_header_t) + setting_bytes;
+
+    printf("Parser benchmark: %d settings, batches of %d configs / %d files\n\n",
+           state.single.setting_count, BENCH_BATCH_CONFIGS, BENCH_BATCH_FILES);
+
+    run_bench(&state, "calculate_checksum", "single", bench_checksum_single, BENCH_SINGLE_OPS, setting_bytes);
+    run_bench(&state, "calculate_checksum", "batch", bench_checksum_batch, BENCH_BATCH_CONFIGS, setting_bytes);
+    run_bench(&state, "get_setting_by_name", "single", bench_lookup_single, BENCH_SINGLE_OPS, sizeof(bios_setting_t));
+    run_bench(&state, "get_setting_by_name", "batch", bench_lookup_batch, BENCH_BATCH_CONFIGS, sizeof(bios_setting_t));
+    if (init_config_snapshot(&state.snapshot, &state.single) == BIOS_SUCCESS) {
+        state.reader = register_snapshot_reader(&state.snapshot);
+        run_bench(&state, "read_snapshot", "single", bench_snapshot_single, BENCH_SINGLE_OPS, sizeof(bios_setting_t));
+        destroy_config_snapshot(&state.snapshot);
+    }
+    run_bench(&state, "validate_all_settings", "single", bench_validate_single, BENCH_SINGLE_OPS, setting_bytes);
+    run_bench(&state, "validate_all_settings", "batch", bench_validate_batch, BENCH_BATCH_CONFIGS, setting_bytes);
+    run_bench(&state, "dedup_store_validate", "batch", bench_validate_dedup, BENCH_BATCH_CONFIGS, setting_bytes);
+    printf("%-22s %-6s %lu validations run, %lu cached\n", "", "",
+           (unsigned long)state.dedup.validations_run, (unsigned long)state.dedup.validations_cached);
+    run_bench(&state, "save_bios_config", "single", bench_save_single, BENCH_SINGLE_FILE_OPS, file_bytes);
+    run_bench(&state, "save_bios_config", "batch", bench_save_batch, BENCH_BATCH_FILES, file_bytes);
+    run_bench(&state, "parse_bios_config", "single", bench_parse_single, BENCH_SINGLE_FILE_OPS, file_bytes);
+    run_bench(&state, "parse_bios_config", "batch", bench_parse_batch, BENCH_BATCH_FILES, file_bytes);
+    set_config_cache_budget((size_t)64 * 1024 * 1024);   // Hold the whole batch
+    run_bench(&state, "acquire_cached_config", "single", bench_cached_single, BENCH_SINGLE_FILE_OPS, file_bytes);
+    run_bench(&state, "acquire_cached_config", "batch", bench_cached_batch, BENCH_BATCH_FILES, file_bytes);
+
+    // Throughput here is output bytes, so measure one pass first
+    state.export_file = fopen("bench_export.tmp", "wb");
+    if (state.export_file) {
+        double jsonl_bytes = (double)bench_export_jsonl(&state, BENCH_BATCH_CONFIGS) / BENCH_BATCH_CONFIGS;
+        run_bench(&state, "export_config_jsonl", "batch", bench_export_jsonl, BENCH_BATCH_CONFIGS, jsonl_bytes);
+        double csv_bytes = (double)bench_export_csv(&state, BENCH_BATCH_CONFIGS) / BENCH_BATCH_CONFIGS;
+        run_bench(&state, "export_config_csv", "batch", bench_export_csv, BENCH_BATCH_CONFIGS, csv_bytes);
+        fclose(state.export_file);
+        remove("bench_export.tmp");
+    }
+
+    // Remove the files written by the save and export workloads
+    char filename[32];
+    remove("bench_single.bin");
+    for (size_t i = 0; i < BENCH_BATCH_FILES; i++) {
+        batch_file_name(filename, sizeof(filename), i);
+        remove(filename);
+    }
+
+    int result = write_results_json(&state, output);
+    if (result == BIOS_SUCCESS) {
+        printf("\nResults written to %s\n", output);
+    }
+
+    free(state.batch);
+    return result == BIOS_SUCCESS ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+/*
+ * Checksum Kernel Benchmark
+ * Compares the integrity kernels over a large batch of configurations
+ */
+#include "../include/config_parser.h"
+#include "../include/checksum.h"
+
+#ifndef _WIN32
+#include <time.h>
+#endif
+
+#define BENCH_CONFIGS 100000
+#define BENCH_ROUNDS 5
+
+static double now_seconds(void) {
+#ifdef _WIN32
+    LARGE_INTEGER freq, counter;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+// Checksum every config in the batch, returning a combined result so the work is not optimized out
+static uint32_t run_batch(const bios_setting_t *batch, int config_count, int setting_count, int use_crc) {
+    size_t config_bytes = sizeof(bios_setting_t) * setting_count;
+    uint32_t combined = 0;
+
+    for (int i = 0; i < config_count; i++) {
+        const bios_setting_t *settings = batch + (size_t)i * setting_count;
+        combined += use_crc ? checksum_crc32c(0, settings, config_bytes) : checksum_sum16(settings, config_bytes);
+    }
+    return combined;
+}
+
+static void bench_kernel(const char *label, checksum_kernel_t kernel, int use_crc,
+                         const bios_setting_t *batch, int setting_count, uint32_t *result) {
+    if (select_checksum_kernel(kernel) != BIOS_SUCCESS) {
+        printf("%-16s not supported on this CPU\n", label);
+        return;
+    }
+
+    double best = 0;
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        double start = now_seconds();
+        *result = run_batch(batch, BENCH_CONFIGS, setting_count, use_crc);
+        double elapsed = now_seconds() - start;
+        if (round == 0 || elapsed < best) {
+            best = elapsed;
+        }
+    }
+
+    double bytes = (double)BENCH_CONFIGS * setting_count * sizeof(bios_setting_t);
+    printf("%-16s %10.1f MB/s %10.1f ns/config  result %08X\n",
+           label, bytes / best / 1e6, best * 1e9 / BENCH_CONFIGS, *result);
+}
+
+int main(void) {
+    bios_config_t config;
+    load_default_config(&config);
+
+    // Build a batch of distinct configurations
+    int setting_count = config.setting_count;
+    bios_setting_t *batch = malloc(sizeof(bios_setting_t) * setting_count * (size_t)BENCH_CONFIGS);
+    if (!batch) {
+        printf("Error: Cannot allocate benchmark batch\n");
+        return 1;
+    }
+    for (int i = 0; i < BENCH_CONFIGS; i++) {
+        uint32_t cpu_freq = 800 + (uint32_t)(i % 4200);
+        set_setting_by_name(&config, "CPU_FREQ", &cpu_freq);
+        memcpy(batch + (size_t)i * setting_count, config.settings, sizeof(bios_setting_t) * setting_count);
+    }
+
+    printf("Checksum benchmark: %d configs x %d settings\n\n", BENCH_CONFIGS, setting_count);
+
+    uint32_t scalar_sum = 0, sse2_sum = 0, avx2_sum = 0, sw_crc = 0, hw_crc = 0;
+    bench_kernel("sum16 scalar", CHECKSUM_KERNEL_SCALAR, 0, batch, setting_count, &scalar_sum);
+    bench_kernel("sum16 sse2", CHECKSUM_KERNEL_SSE2, 0, batch, setting_count, &sse2_sum);
+    bench_kernel("sum16 avx2", CHECKSUM_KERNEL_AVX2, 0, batch, setting_count, &avx2_sum);
+    bench_kernel("crc32c table", CHECKSUM_KERNEL_SCALAR, 1, batch, setting_count, &sw_crc);
+    select_checksum_kernel(CHECKSUM_KERNEL_AUTO);
+    if (checksum_crc32c_hardware()) {
+        bench_kernel("crc32c sse4.2", CHECKSUM_KERNEL_AUTO, 1, batch, setting_count, &hw_crc);
+    } else {
+        printf("%-16s not supported on this CPU\n", "crc32c sse4.2");
+        hw_crc = sw_crc;
+    }
+
+    // Every kernel must agree with the scalar reference
+    int mismatch = (sse2_sum && sse2_sum != scalar_sum) || (avx2_sum && avx2_sum != scalar_sum) || hw_crc != sw_crc;
+    printf("\n%s\n", mismatch ? "ERROR: kernel results differ" : "All kernels agree");
+
+    free(batch);
+    return mismatch ? 1 : 0;
+}
\ No newline at end of file
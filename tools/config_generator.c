@@ -1,8 +1,24 @@
 /*
  * System Configuration Generator
- * Creates preset configuration files for testing
+ * Creates preset configuration files for testing, or with --fleet a large,
+ * reproducible synthetic fleet for load testing
  */
 #include "../include/config_parser.h"
+#include "../include/config_delta.h"
+#include "../include/config_archive.h"
+#include "../include/fleet_loader.h"
+#include "../include/thread_pool.h"
+#include <stdatomic.h>
+
+#ifdef _WIN32
+#define PATH_SEPARATOR "\\"
+#else
+#include <time.h>
+#define PATH_SEPARATOR "/"
+#endif
+
+#define GEN_MAX_CHOICES 8
+#define GEN_CHUNK_CONFIGS 65536    // Configs generated per pool run in archive mode
 
 void create_performance_config(bios_config_t *config) {
     load_default_config(config);
@@ -36,26 +52,394 @@ void create_stability_config(bios_config_t *config) {
     printf("Stability configuration created\n");
 }
 
-int main(void) {
+// Store a profile as a delta against the default configuration
+static void save_profile_delta(const bios_config_t *base, const bios_config_t *profile, const char *filename) {
+    uint8_t delta[MAX_DELTA_SIZE(MAX_SETTINGS)];
+    size_t delta_size;
+    
+    if (create_config_delta(base, profile, delta, sizeof(delta), &delta_size) == BIOS_SUCCESS) {
+        save_config_delta(filename, delta, delta_size);
+    }
+}
+
+// Per-setting value distributions
+typedef enum {
+    DIST_RANGE = 0,     // Uniform over the setting's own min..max (default)
+    DIST_FIXED,
+    DIST_UNIFORM,
+    DIST_NORMAL,        // Clamped to the setting's range
+    DIST_CHOICE
+} dist_kind_t;
+
+typedef struct {
+    dist_kind_t kind;
+    double a;           // Fixed value, low bound or mean
+    double b;           // High bound or standard deviation
+    uint32_t choices[GEN_MAX_CHOICES];
+    int choice_count;
+} setting_dist_t;
+
+typedef struct {
+    bios_config_t template_config;
+    setting_dist_t dists[MAX_SETTINGS];
+    uint64_t seed;
+    double out_of_range_rate;
+    double corrupt_rate;
+    const char *directory;          // Individual files
+    uint8_t *chunk;                 // Archive mode: images for the current chunk
+    size_t chunk_base;
+    size_t image_size;              // Every generated image has the same size
+    _Atomic size_t out_of_range_count;
+    _Atomic size_t corrupt_count;
+    _Atomic size_t error_count;
+} fleet_gen_t;
+
+// splitmix64: each config gets its own stream, so output does not depend on thread scheduling
+static uint64_t next_random(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static double next_unit(uint64_t *state) {
+    return (next_random(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static uint32_t type_max_value(const bios_setting_t *setting) {
+    switch (setting->type) {
+        case BIOS_TYPE_UINT8:  return 0xFF;
+        case BIOS_TYPE_UINT16: return 0xFFFF;
+        case BIOS_TYPE_UINT32: return 0xFFFFFFFFU;
+        default:               return 1;
+    }
+}
+
+static void store_value(bios_setting_t *setting, uint32_t value) {
+    if (setting->type == BIOS_TYPE_UINT16) {
+        uint16_t narrow = (uint16_t)value;
+        memcpy(setting->data, &narrow, sizeof(narrow));
+    } else if (setting->type == BIOS_TYPE_UINT32) {
+        memcpy(setting->data, &value, sizeof(value));
+    } else {
+        setting->data[0] = (uint8_t)value;
+    }
+}
+
+static uint32_t draw_value(const setting_dist_t *dist, const bios_setting_t *setting, uint64_t *state) {
+    double low = setting->min_value;
+    double high = setting->type == BIOS_TYPE_BOOL ? 1 : setting->max_value;
+    double value;
+
+    switch (dist->kind) {
+        case DIST_FIXED:
+            return (uint32_t)dist->a;
+        case DIST_CHOICE:
+            return dist->choices[next_random(state) % (uint64_t)dist->choice_count];
+        case DIST_UNIFORM:
+            low = dist->a;
+            high = dist->b;
+            value = low + next_unit(state) * (high - low + 1);
+            break;
+        case DIST_NORMAL: {
+            // Sum of four uniforms, scaled to unit variance
+            double sum = next_unit(state) + next_unit(state) + next_unit(state) + next_unit(state);
+            value = dist->a + (sum - 2.0) * 1.7320508075688772 * dist->b + 0.5;
+            break;
+        }
+        default:
+            value = low + next_unit(state) * (high - low + 1);
+            break;
+    }
+
+    if (value < low) {
+        value = low;
+    }
+    if (value > high) {
+        value = high;
+    }
+    return (uint32_t)value;
+}
+
+// Build config number index into image; deterministic for a given seed
+static void generate_image(fleet_gen_t *gen, size_t index, uint8_t *image) {
+    uint64_t state = gen->seed ^ ((uint64_t)index * 0xD1B54A32D192ED03ULL);
+    const bios_config_t *base = &gen->template_config;
+    bios_setting_t settings[MAX_SETTINGS];
+    memcpy(settings, base->settings, sizeof(bios_setting_t) * base->setting_count);
+
+    for (int i = 0; i < base->setting_count; i++) {
+        store_value(&settings[i], draw_value(&gen->dists[i], &settings[i], &state));
+    }
+
+    // Out-of-range value: still checksummed correctly, so only validation catches it
+    if (next_unit(&state) < gen->out_of_range_rate) {
+        bios_setting_t *victim = &settings[next_random(&state) % (uint64_t)base->setting_count];
+        uint32_t bad;
+        if (victim->type == BIOS_TYPE_BOOL) {
+            bad = 2;
+        } else if (victim->max_value < type_max_value(victim)) {
+            bad = victim->max_value + 1 + (uint32_t)(next_random(&state) % 16);
+            if (bad > type_max_value(victim) || bad <= victim->max_value) {
+                bad = type_max_value(victim);
+            }
+        } else {
+            bad = victim->min_value > 0 ? victim->min_value - 1 : victim->max_value;
+        }
+        store_value(victim, bad);
+        atomic_fetch_add(&gen->out_of_range_count, 1);
+    }
+
+    size_t image_size;
+    serialize_config_image(&base->header, settings, base->setting_count, base->integrity,
+                           image, gen->image_size, &image_size);
+
+    // Corruption: flip one bit of setting data after the checksum was computed
+    if (next_unit(&state) < gen->corrupt_rate) {
+        size_t data_size = sizeof(bios_setting_t) * base->setting_count;
+        size_t offset = image_size - data_size + (size_t)(next_random(&state) % data_size);
+        image[offset] ^= (uint8_t)(1u << (next_random(&state) % 8));
+        atomic_fetch_add(&gen->corrupt_count, 1);
+    }
+}
+
+static void generate_file_task(void *context, size_t index, int worker) {
+    fleet_gen_t *gen = context;
+    uint8_t image[MAX_CONFIG_IMAGE_SIZE(MAX_SETTINGS)];
+    char path[FLEET_PATH_MAX];
+    bios_report_t report;
+    (void)worker;
+
+    generate_image(gen, index, image);
+    snprintf(path, sizeof(path), "%s" PATH_SEPARATOR "node%08lu.bin", gen->directory, (unsigned long)index);
+    init_report(&report);
+    if (write_file_atomic(path, image, gen->image_size, NULL, &report) != BIOS_SUCCESS) {
+        atomic_fetch_add(&gen->error_count, 1);
+    }
+}
+
+static void generate_chunk_task(void *context, size_t index, int worker) {
+    fleet_gen_t *gen = context;
+    (void)worker;
+    generate_image(gen, gen->chunk_base + index, gen->chunk + index * gen->image_size);
+}
+
+// Values that are stored as drawn must fit the 32-bit setting value (NaN fails both tests)
+static int storable_value(double value) {
+    return value >= 0 && value <= (double)UINT32_MAX;
+}
+
+// NAME=fixed:V | NAME=uniform:LO:HI | NAME=normal:MEAN:STDDEV | NAME=choice:A,B,...
+static int parse_dist_spec(fleet_gen_t *gen, const char *spec) {
+    char name[MAX_SETTING_NAME];
+    const char *equals = strchr(spec, '=');
+    if (!equals || equals == spec || (size_t)(equals - spec) >= sizeof(name)) {
+        return BIOS_ERROR_FORMAT;
+    }
+    snprintf(name, sizeof(name), "%.*s", (int)(equals - spec), spec);
+
+    int idx = find_setting_index(&gen->template_config, name);
+    if (idx < 0) {
+        printf("Error: Unknown setting %s\n", name);
+        return BIOS_ERROR_INVALID_SETTING;
+    }
+
+    setting_dist_t *dist = &gen->dists[idx];
+    const char *args = equals + 1;
+    memset(dist, 0, sizeof(setting_dist_t));
+    if (sscanf(args, "fixed:%lf", &dist->a) == 1 && storable_value(dist->a)) {
+        dist->kind = DIST_FIXED;
+    } else if (sscanf(args, "uniform:%lf:%lf", &dist->a, &dist->b) == 2 && dist->a <= dist->b &&
+               storable_value(dist->a) && storable_value(dist->b)) {
+        dist->kind = DIST_UNIFORM;
+    } else if (sscanf(args, "normal:%lf:%lf", &dist->a, &dist->b) == 2 && dist->b >= 0) {
+        dist->kind = DIST_NORMAL;
+    } else if (strncmp(args, "choice:", 7) == 0) {
+        dist->kind = DIST_CHOICE;
+        const char *cursor = args + 7;
+        while (*cursor && dist->choice_count < GEN_MAX_CHOICES) {
+            char *end;
+            dist->choices[dist->choice_count++] = (uint32_t)strtoul(cursor, &end, 0);
+            if (end == cursor) {
+                return BIOS_ERROR_FORMAT;
+            }
+            cursor = *end == ',' ? end + 1 : end;
+        }
+        if (dist->choice_count == 0 || *cursor) {
+            return BIOS_ERROR_FORMAT;
+        }
+    } else {
+        return BIOS_ERROR_FORMAT;
+    }
+    return BIOS_SUCCESS;
+}
+
+static double now_seconds(void) {
+#ifdef _WIN32
+    LARGE_INTEGER freq, counter;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+// Write the fleet as one archive, chunk by chunk, in index order
+static int generate_fleet_archive(fleet_gen_t *gen, const char *filename, size_t count, int threads, int packed) {
+    bios_archive_writer_t writer;
+    int opened = packed ? open_packed_archive_writer(filename, &writer) : open_archive_writer(filename, &writer);
+    if (opened != BIOS_SUCCESS) {
+        return BIOS_ERROR_FILE;
+    }
+
+    gen->chunk = malloc(gen->image_size * GEN_CHUNK_CONFIGS);
+    if (!gen->chunk) {
+        printf("Error: Cannot allocate generation buffer\n");
+        close_archive_writer(&writer);
+        return BIOS_ERROR_FILE;
+    }
+
+    int result = BIOS_SUCCESS;
+    for (gen->chunk_base = 0; gen->chunk_base < count && result == BIOS_SUCCESS; gen->chunk_base += GEN_CHUNK_CONFIGS) {
+        size_t chunk_count = count - gen->chunk_base < GEN_CHUNK_CONFIGS ? count - gen->chunk_base : GEN_CHUNK_CONFIGS;
+        result = run_thread_pool(chunk_count, threads, generate_chunk_task, gen);
+
+        char key[ARCHIVE_KEY_LEN];
+        for (size_t i = 0; i < chunk_count && result == BIOS_SUCCESS; i++) {
+            snprintf(key, sizeof(key), "node%08lu", (unsigned long)(gen->chunk_base + i));
+            result = archive_append_record(&writer, key, gen->chunk + i * gen->image_size, gen->image_size);
+        }
+    }
+
+    free(gen->chunk);
+    gen->chunk = NULL;
+    if (close_archive_writer(&writer) != BIOS_SUCCESS) {
+        result = BIOS_ERROR_FILE;
+    }
+    return result;
+}
+
+static void print_fleet_usage(void) {
+    printf("Usage: config_gen --fleet --count N (--dir DIR | --archive FILE) [options]\n");
+    printf("   --seed S            Random seed (default 1); same seed, same fleet\n");
+    printf("   --threads N         Worker threads (default: one per core)\n");
+    printf("   --dist NAME=SPEC    fixed:V, uniform:LO:HI, normal:MEAN:STDDEV or choice:A,B,...\n");
+    printf("                       (default: uniform over the setting's own range)\n");
+    printf("   --out-of-range P    Fraction of configs with one out-of-range value\n");
+    printf("   --corrupt P         Fraction of configs with a bit flipped after checksumming\n");
+    printf("   --crc32c            Write version 2 files with a CRC32C\n");
+    printf("   --packed            Compress the archive (shared name dictionary, bit-packed values)\n");
+}
+
+// Synthetic fleet for load testing
+static int run_fleet_generator(int argc, char *argv[]) {
+    static fleet_gen_t gen;
+    const char *archive = NULL;
+    size_t count = 0;
+    int threads = 0;
+    int packed = 0;
+
+    load_default_config(&gen.template_config);
+    gen.seed = 1;
+
+    for (int i = 2; i < argc; i++) {
+        int has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--count") == 0 && has_value) {
+            count = strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--seed") == 0 && has_value) {
+            gen.seed = strtoull(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--threads") == 0 && has_value) {
+            threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--dir") == 0 && has_value) {
+            gen.directory = argv[++i];
+        } else if (strcmp(argv[i], "--archive") == 0 && has_value) {
+            archive = argv[++i];
+        } else if (strcmp(argv[i], "--out-of-range") == 0 && has_value) {
+            gen.out_of_range_rate = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--corrupt") == 0 && has_value) {
+            gen.corrupt_rate = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--crc32c") == 0) {
+            gen.template_config.integrity = BIOS_INTEGRITY_CRC32C;
+        } else if (strcmp(argv[i], "--packed") == 0) {
+            packed = 1;
+        } else if (strcmp(argv[i], "--dist") == 0 && has_value) {
+            if (parse_dist_spec(&gen, argv[++i]) != BIOS_SUCCESS) {
+                printf("Error: Invalid distribution '%s'\n", argv[i]);
+                return 1;
+            }
+        } else {
+            print_fleet_usage();
+            return 1;
+        }
+    }
+    if (count == 0 || (!gen.directory) == (!archive) || (packed && !archive)) {
+        print_fleet_usage();
+        return 1;
+    }
+
+    gen.image_size = sizeof(bios_config_header_t) + sizeof(bios_setting_t) * gen.template_config.setting_count;
+    if (gen.template_config.integrity == BIOS_INTEGRITY_CRC32C) {
+        gen.image_size += sizeof(bios_integrity_ext_t);
+    }
+
+    printf("Generating %lu configurations (seed %lu)...\n", (unsigned long)count, (unsigned long)gen.seed);
+    double start = now_seconds();
+    int result;
+    if (archive) {
+        result = generate_fleet_archive(&gen, archive, count, threads, packed);
+    } else {
+        // Load-test data: atomic replacement, but no flushing per file
+        set_save_durability(SAVE_DURABILITY_NONE);
+        result = run_thread_pool(count, threads, generate_file_task, &gen);
+        if (atomic_load(&gen.error_count)) {
+            printf("Error: %lu files could not be written\n", (unsigned long)atomic_load(&gen.error_count));
+            result = BIOS_ERROR_FILE;
+        }
+    }
+    double elapsed = now_seconds() - start;
+
+    printf("Wrote %lu configurations to %s in %.2f s (%.0f configs/s, %.1f MB/s)\n",
+           (unsigned long)count, archive ? archive : gen.directory, elapsed, count / elapsed,
+           (double)count * gen.image_size / elapsed / 1e6);
+    printf("Out-of-range configs: %lu, corrupted configs: %lu\n",
+           (unsigned long)atomic_load(&gen.out_of_range_count), (unsigned long)atomic_load(&gen.corrupt_count));
+    return result == BIOS_SUCCESS ? 0 : 1;
+}
+
+int main(int argc, char *argv[]) {
     bios_config_t config;
+    bios_config_t defaults;
+    
+    if (argc > 1) {
+        if (strcmp(argv[1], "--fleet") == 0) {
+            return run_fleet_generator(argc, argv);
+        }
+        print_fleet_usage();
+        return 1;
+    }
     
     printf("System Configuration Generator\n");
     printf("==============================\n\n");
     
     // Create default configuration
     printf("Creating default.bin...\n");
-    load_default_config(&config);
-    save_bios_config("configs\\default.bin", &config);
+    load_default_config(&defaults);
+    save_bios_config("configs\\default.bin", &defaults);
     
     // Create performance configuration
     printf("Creating performance.bin...\n");
     create_performance_config(&config);
     save_bios_config("configs\\performance.bin", &config);
+    save_profile_delta(&defaults, &config, "configs\\performance.delta");
     
     // Create stability configuration
     printf("Creating stability.bin...\n");
     create_stability_config(&config);
     save_bios_config("configs\\stability.bin", &config);
+    save_profile_delta(&defaults, &config, "configs\\stability.delta");
     
     printf("\nConfiguration files created successfully!\n");
     printf("Use these files to test the configuration parser.\n");